@@ -39,8 +39,7 @@ HEADERS += include/stable.h \
            include/game/Displayable.h \
            include/game/Projectile.h \
            include/game/ProjectileAlien.h \
-           include/game/ProjectileCross.h \
-           include/game/ProjectileSimple.h \
+           include/game/LinearProjectile.h \
            include/game/ProjectileV.h \
            include/game/Spaceship.h \
            include/game/Supernova.h \
@@ -69,7 +68,6 @@ HEADERS += include/stable.h \
     include/engine/DemoEngine.h \
     include/menu/KinectWindow.h \
     include/engine/DemoEngine.h \
-    include/game/ProjectileBlack.h \
     include/menu/ConnectDialog.h \
     include/menu/StateWidget.h \
     include/menu/ScrollText.h
@@ -99,8 +97,6 @@ SOURCES += src/main.cpp \
            src/game/Displayable.cpp \
            src/game/Projectile.cpp \
            src/game/ProjectileAlien.cpp \
-           src/game/ProjectileCross.cpp \
-           src/game/ProjectileSimple.cpp \
            src/game/ProjectileV.cpp \
            src/game/Spaceship.cpp \
            src/game/Supernova.cpp \
@@ -129,7 +125,6 @@ SOURCES += src/main.cpp \
     src/menu/ConnectDialog.cpp \
     src/game/BlackShip.cpp \
     src/menu/StateWidget.cpp \
-    src/game/ProjectileBlack.cpp \
     src/menu/ScrollText.cpp
 
 RESOURCES += ressources.qrc
@@ -0,0 +1,47 @@
+#ifndef HANDS_READER_H
+#define HANDS_READER_H
+
+#include "include/kinect/qkinect.h"
+#include "include/utils/LatencyStats.h"
+
+//Reads the hands on the GUI thread each time the Kinect has new data,
+//like GameEngine::positionProcess does during a match
+class HandsReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    HandsReader(QKinect* _kinect) :kinect(_kinect),nbReads(0) {}
+
+    int count() const {return nbReads;}
+    const LatencyStats& readCost() const {return cost;}
+    //(ms) since the last read, or since reset()
+    qint64 idleTime() const {return lastRead.isValid() ? lastRead.elapsed() : 0;}
+
+    void reset()
+    {
+        nbReads = 0;
+        cost.clear();
+        lastRead.start();
+    }
+
+public slots:
+    void read()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        kinect->getHandsPosition();
+        cost.addSample(timer.nsecsElapsed()/1000);
+
+        nbReads++;
+        lastRead.start();
+    }
+
+private:
+    QKinect* kinect;
+    int nbReads;
+    LatencyStats cost;//(us)
+    QElapsedTimer lastRead;
+};
+
+#endif // HANDS_READER_H
@@ -0,0 +1,511 @@
+#include "bench/HandsReader.h"
+#include "include/kinect/qkinect.h"
+#include "include/kinect/RectangleDetection.h"
+#include "include/kinect/RecordedKinectSensor.h"
+#include "include/kinect/SkeletonRecording.h"
+#include "include/utils/LatencyStats.h"
+
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include <cstring>
+#include <vector>
+
+//Times the Kinect pipeline on recorded data, without a Kinect :
+//  Starfighter4KKinectBench [--repeat n] [--speed s] <recording>
+//  Starfighter4KKinectBench [--repeat n] --images <image>...
+//The recording comes from Starfighter4K --record <file>, its color frames are
+//the ones of the calibration. The images are stored camera frames of any size.
+//A recording is then played through QKinect, at s times its pace (1 by default,
+//0 as fast as it is read) : calibration, processSkeleton, then getHandsPosition
+//on this thread for each newDatas, like a match. The age of the hands only
+//means something at speed 1, at 0 it is mostly the queue of newDatas.
+//The lag of the hands is measured apart, on the skeleton frames of the recording
+//(raw joints) : the smoothing of the SDK the game used before, the One-Euro filter
+//without and with its prediction each filter the hand track, the lag is the time
+//shift that lays their output best on the raw track.
+//Only the Visual Studio solution builds it : Starfighter4K.pro has none of the
+//Kinect sources yet, so this does not build on Linux.
+//The exit code is 1 when the pyramid search and the full resolution one don't
+//find the same corners on a frame, within the tolerance of the calibration.
+namespace
+{
+    const double kAgreement = 2.0;//(pixels) the tolerance of the calibration
+    const int kScreenWidth = 1920;
+    const int kScreenHeight = 1080;
+    const int kMinShift = -100;//(ms) range searched for the lag of a filter
+    const int kMaxShift = 300;
+
+    //Default parameters of NuiTransformSmooth, the game passed it NULL
+    const float kSmoothing = 0.5f;
+    const float kCorrection = 0.5f;
+    const float kPrediction = 0.5f;//(frames)
+    const float kJitterRadius = 0.05f;//(m)
+    const float kMaxDeviation = 0.04f;//(m)
+
+    qint64 elapsedUs(const QElapsedTimer& _timer)
+    {
+        return _timer.nsecsElapsed()/1000;
+    }
+
+    //Color frames of the recording, in place in the mapped file (BGRA, like the sensor gives them)
+    std::vector<cv::Mat> recordedColorFrames(const SkeletonRecording& _recording)
+    {
+        std::vector<cv::Mat> frames;
+        for(int i = 0; i < _recording.count(); ++i)
+            if(_recording.kind(i) == SkeletonRecordingFormat::ColorKind && _recording.size(i) >= static_cast<quint32>(video_width*video_height*4))
+                frames.push_back(cv::Mat(video_height, video_width, CV_8UC4, const_cast<uchar*>(_recording.payload(i))));
+        return frames;
+    }
+
+    //Stored frames, brought to the format and the size of the camera
+    std::vector<cv::Mat> imageFrames(const QStringList& _paths)
+    {
+        std::vector<cv::Mat> frames;
+        for(int i = 0; i < _paths.size(); ++i)
+        {
+            cv::Mat image = cv::imread(_paths[i].toLocal8Bit().constData());
+            if(image.empty())
+            {
+                qDebug() << "Can't read" << _paths[i];
+                continue;
+            }
+
+            cv::Mat frame;
+            cv::cvtColor(image, frame, CV_BGR2BGRA);
+            if(frame.cols != video_width || frame.rows != video_height)
+                cv::resize(frame, frame, cv::Size(video_width, video_height));
+            frames.push_back(frame);
+        }
+        return frames;
+    }
+
+    //Largest distance from a corner of _square to the nearest corner of _reference
+    double cornerError(const std::vector<cv::Point>& _square, const std::vector<cv::Point>& _reference)
+    {
+        double error = 0.0;
+        for(size_t i = 0; i < _square.size(); ++i)
+        {
+            double nearest = -1.0;
+            for(size_t j = 0; j < _reference.size(); ++j)
+            {
+                double distance = cv::norm(_square[i] - _reference[j]);
+                if(nearest < 0.0 || distance < nearest)
+                    nearest = distance;
+            }
+            error = qMax(error, nearest);
+        }
+        return error;
+    }
+
+    //Each search on every frame, then whole calibrations fed with the frames in a loop.
+    //False if the pyramid search disagrees with the full resolution one on a frame
+    bool benchCalibration(const std::vector<cv::Mat>& _frames, int _repeat)
+    {
+        LatencyStats fullSearch, pyramidSearch, calibration;
+        int found = 0, foundPyramid = 0, nbImages = 0;
+        int disagreements = 0;
+        double maxError = 0.0;
+
+        QElapsedTimer timer;
+        for(int r = 0; r < _repeat; ++r)
+            for(size_t i = 0; i < _frames.size(); ++i)
+            {
+                std::vector<std::vector<cv::Point> > reference;
+                timer.start();
+                bool isFound = findSquares(_frames[i], reference, 0, 0);
+                fullSearch.addSample(elapsedUs(timer));
+
+                std::vector<std::vector<cv::Point> > squares;
+                timer.start();
+                bool isFoundPyramid = findSquaresPyramid(_frames[i], squares);
+                pyramidSearch.addSample(elapsedUs(timer));
+
+                found += isFound ? 1 : 0;
+                foundPyramid += isFoundPyramid ? 1 : 0;
+
+                //Checked on the first pass only, the searches are deterministic
+                if(r != 0)
+                    continue;
+                double error = (isFound && isFoundPyramid) ? cornerError(squares[0], reference[0]) : 0.0;
+                maxError = qMax(maxError, error);
+                if(isFound != isFoundPyramid || error > kAgreement)
+                {
+                    qDebug() << "Frame" << i << ": full resolution" << (isFound ? "found" : "missed")
+                             << ", pyramid" << (isFoundPyramid ? "found" : "missed") << ", corner error" << error << "px";
+                    disagreements++;
+                }
+            }
+
+        for(int r = 0; r < _repeat; ++r)
+        {
+            RectangleDetection detection;
+            timer.start();
+            for(size_t i = 0; !detection.isDone(); i = (i+1) % _frames.size())
+                detection.addImage(_frames[i]);
+            calibration.addSample(elapsedUs(timer));
+            nbImages += detection.getSizeImages();
+        }
+
+        qDebug() << "Full resolution search :" << fullSearch.summary("us") << "|" << found << "squares";
+        qDebug() << "Pyramid search :" << pyramidSearch.summary("us") << "|" << foundPyramid << "squares";
+        qDebug() << "Calibration :" << calibration.summary("us") << "|" << nbImages/_repeat << "images each";
+        qDebug() << "Pyramid against full resolution :" << disagreements << "frame(s) over" << kAgreement << "px, largest corner error" << maxError << "px";
+        return disagreements == 0;
+    }
+
+    //Holt double exponential smoothing of NuiTransformSmooth, on one joint in skeleton space
+    class SdkSmoothing
+    {
+    public:
+        SdkSmoothing() :nbFrames(0) {}
+
+        void reset() {nbFrames = 0;}
+
+        JointPosition smooth(const JointPosition& _joint)
+        {
+            cv::Point3f raw(_joint.x, _joint.y, _joint.z);
+            cv::Point3f filtered;
+            if(nbFrames == 0)
+            {
+                filtered = raw;
+                trend = cv::Point3f();
+            }
+            else if(nbFrames == 1)
+            {
+                filtered = (raw+previousRaw)*0.5f;
+                trend = (filtered-previousFiltered)*kCorrection + trend*(1.0f-kCorrection);
+            }
+            else
+            {
+                //Moves within the jitter radius are damped before the smoothing
+                cv::Point3f input = raw;
+                float jitter = static_cast<float>(cv::norm(raw-previousFiltered));
+                if(jitter <= kJitterRadius)
+                    input = raw*(jitter/kJitterRadius) + previousFiltered*(1.0f-jitter/kJitterRadius);
+
+                filtered = input*(1.0f-kSmoothing) + (previousFiltered+trend)*kSmoothing;
+                trend = (filtered-previousFiltered)*kCorrection + trend*(1.0f-kCorrection);
+            }
+            previousRaw = raw;
+            previousFiltered = filtered;
+            nbFrames++;
+
+            //The prediction never strays further than kMaxDeviation from the raw joint
+            cv::Point3f predicted = filtered + trend*kPrediction;
+            float deviation = static_cast<float>(cv::norm(predicted-raw));
+            if(deviation > kMaxDeviation)
+                predicted = predicted*(kMaxDeviation/deviation) + raw*(1.0f-kMaxDeviation/deviation);
+
+            JointPosition joint = {predicted.x, predicted.y, predicted.z, _joint.w};
+            return joint;
+        }
+
+    private:
+        int nbFrames;
+        cv::Point3f previousRaw;
+        cv::Point3f previousFiltered;
+        cv::Point3f trend;//(m/frame)
+    };
+
+    //How the hands are filtered : the smoothing of the SDK on the joints, or the One-Euro filter on the screen
+    struct FilterSetup
+    {
+        FilterSetup(const QString& _name, bool _sdkSmoothing, qreal _prediction) :name(_name),sdkSmoothing(_sdkSmoothing)
+        {
+            oneEuro.prediction = _prediction;
+        }
+
+        QString name;
+        bool sdkSmoothing;
+        HandFilter::Parameters oneEuro;
+    };
+
+    //Frames in a row where the hand of a player was followed (screen pixels)
+    struct HandStretch
+    {
+        std::vector<qreal> times;//(s) timestamps of the sensor
+        std::vector<QPointF> raw;
+        std::vector<QPointF> filtered;
+    };
+
+    //Same transformation as QKinect::JointToScreen, without the rounding
+    QPointF jointToScreen(const KinectSensor& _sensor, const ScreenMapping& _mapping, const JointPosition& _joint)
+    {
+        cv::Point2f depth = _sensor.toDepthImage(_joint);
+        cv::Point2f screen = _mapping.map(depth.x, depth.y);
+        return QPointF(kScreenWidth - screen.x*kScreenWidth, screen.y*kScreenHeight);
+    }
+
+    //The hands of the skeleton frames of the recording, selected like QKinect::updateHands does, raw and filtered.
+    //The selection is made on the raw joints so both tracks always follow the same hand
+    std::vector<HandStretch> trackHands(const SkeletonRecording& _recording, const KinectSensor& _sensor, const ScreenMapping& _mapping, const FilterSetup& _setup)
+    {
+        static const int kNbJoints = 3;
+        const JointIndex joints[kNbJoints] = {JointHead, JointHandLeft, JointHandRight};
+
+        std::vector<HandStretch> stretches;
+        int current[2] = {-1, -1};//stretch of each player, -1 while the hand is lost
+        HandFilter filters[2];
+        for(int p = 0; p < 2; ++p)
+            filters[p].setParameters(_setup.oneEuro);
+        SdkSmoothing smoothing[SkeletonFrame::kSkeletonCount][kNbJoints];
+        qint64 lastTimestamp = 0;
+
+        SkeletonFrame frame;
+        for(int f = 0; f < _recording.count(); ++f)
+        {
+            if(_recording.kind(f) != SkeletonRecordingFormat::SkeletonKind || _recording.size(f) < sizeof(SkeletonFrame))
+                continue;
+            memcpy(&frame, _recording.payload(f), sizeof(SkeletonFrame));
+
+            QPointF raw[2], smoothed[2];
+            bool found[2] = {false, false};
+            for(int i = 0; i < SkeletonFrame::kSkeletonCount; ++i)
+            {
+                if(frame.states[i] != SkeletonTracked)
+                {
+                    for(int j = 0; j < kNbJoints; ++j)
+                        smoothing[i][j].reset();
+                    continue;
+                }
+
+                QPointF points[kNbJoints], smoothedPoints[kNbJoints];
+                for(int j = 0; j < kNbJoints; ++j)
+                {
+                    const JointPosition& joint = frame.joints[i][joints[j]];
+                    points[j] = jointToScreen(_sensor, _mapping, joint);
+                    if(_setup.sdkSmoothing)
+                        smoothedPoints[j] = jointToScreen(_sensor, _mapping, smoothing[i][j].smooth(joint));
+                }
+
+                int player = points[0].x() < kScreenWidth/2 ? 0 : 1;
+                bool rightHand = (player == 0) ? points[2].x() > points[1].x() : points[2].x() < points[1].x();
+                raw[player] = points[rightHand ? 2 : 1];
+                smoothed[player] = smoothedPoints[rightHand ? 2 : 1];
+                found[player] = true;
+            }
+
+            qreal dt = (lastTimestamp != 0 && frame.timestamp > lastTimestamp) ? (frame.timestamp-lastTimestamp)/1000.0 : 1.0/30.0;
+            lastTimestamp = frame.timestamp;
+
+            for(int p = 0; p < 2; ++p)
+            {
+                if(!found[p])
+                {
+                    current[p] = -1;
+                    filters[p].reset();
+                    continue;
+                }
+                if(current[p] < 0)
+                {
+                    current[p] = static_cast<int>(stretches.size());
+                    stretches.push_back(HandStretch());
+                }
+
+                HandStretch& stretch = stretches[current[p]];
+                stretch.times.push_back(frame.timestamp/1000.0);
+                stretch.raw.push_back(raw[p]);
+                stretch.filtered.push_back(_setup.sdkSmoothing ? smoothed[p] : filters[p].filter(raw[p], dt));
+            }
+        }
+        return stretches;
+    }
+
+    //Time shift (s) that lays the filtered track best on the raw one : the lag of the filter, negative when it
+    //runs ahead. _distance receives what is left between the tracks at that shift (pixels, rms), jitter included
+    qreal bestShift(const std::vector<HandStretch>& _stretches, qreal& _distance, int& _samples)
+    {
+        qreal best = 0.0;
+        _distance = -1.0;
+        _samples = 0;
+        for(int ms = kMinShift; ms <= kMaxShift; ++ms)
+        {
+            qreal shift = ms/1000.0;
+            qreal error = 0.0;
+            int count = 0;
+            for(size_t s = 0; s < _stretches.size(); ++s)
+            {
+                const HandStretch& stretch = _stretches[s];
+                size_t j = 0;
+                for(size_t i = 0; i < stretch.times.size(); ++i)
+                {
+                    //The raw position shift earlier, interpolated between its frames
+                    qreal time = stretch.times[i]-shift;
+                    if(time < stretch.times.front() || time > stretch.times.back())
+                        continue;
+                    while(j+1 < stretch.times.size() && stretch.times[j+1] < time)
+                        ++j;
+
+                    QPointF raw = stretch.raw[j];
+                    if(j+1 < stretch.times.size() && stretch.times[j+1] > stretch.times[j])
+                    {
+                        qreal a = (time-stretch.times[j])/(stretch.times[j+1]-stretch.times[j]);
+                        raw = stretch.raw[j]*(1.0-a) + stretch.raw[j+1]*a;
+                    }
+
+                    QPointF difference = stretch.filtered[i]-raw;
+                    error += difference.x()*difference.x() + difference.y()*difference.y();
+                    count++;
+                }
+            }
+
+            if(count == 0)
+                continue;
+            error = std::sqrt(error/count);
+            if(_distance < 0.0 || error < _distance)
+            {
+                _distance = error;
+                _samples = count;
+                best = shift;
+            }
+        }
+        return best;
+    }
+
+    //The lag of each filter of the hands, on the joints of the recording played offline.
+    //The recording must hold raw joints, as the game records them since the smoothing moved to HandFilter
+    bool benchLag(const QString& _path, const SkeletonRecording& _recording, const std::vector<cv::Mat>& _frames)
+    {
+        RectangleDetection detection;
+        for(size_t i = 0; !detection.isDone(); i = (i+1) % _frames.size())
+            detection.addImage(_frames[i]);
+        ScreenMapping mapping;
+        mapping.calibrate(detection.getPoints(), static_cast<double>(ScreenMapping::kGridWidth) / video_width);
+
+        //Only its projection is used, the sensor is not opened
+        RecordedKinectSensor sensor(_path);
+
+        HandFilter::Parameters defaults;
+        std::vector<FilterSetup> setups;
+        setups.push_back(FilterSetup("Smoothing of the SDK (before)", true, 0.0));
+        setups.push_back(FilterSetup("One-Euro without prediction", false, 0.0));
+        setups.push_back(FilterSetup(QString("One-Euro, prediction %1 ms").arg(defaults.prediction*1000), false, defaults.prediction));
+
+        bool measured = true;
+        for(size_t i = 0; i < setups.size(); ++i)
+        {
+            qreal distance;
+            int samples;
+            qreal lag = bestShift(trackHands(_recording, sensor, mapping, setups[i]), distance, samples);
+            if(samples == 0)
+            {
+                qDebug() << setups[i].name << ": no hand followed in the recording";
+                measured = false;
+                continue;
+            }
+            qDebug() << setups[i].name << ": lag" << lag*1000 << "ms | distance to the raw track" << distance << "px rms over" << samples << "frames";
+        }
+        return measured;
+    }
+
+    //The recording through the whole QKinect path, until it has no more frames to give
+    bool benchPlayback(const QString& _path, qreal _speed)
+    {
+        QSize screen(kScreenWidth, kScreenHeight);
+        QKinect kinect(&screen, new RecordedKinectSensor(_path, _speed));
+        HandsReader reader(&kinect);
+        QObject::connect(&kinect, SIGNAL(newDatas()), &reader, SLOT(read()));
+
+        //The skeleton frames that come during the calibration are not mapped yet, they are left out
+        QEventLoop loop;
+        QObject::connect(&kinect, SIGNAL(calibrated()), &loop, SLOT(quit()));
+        QTimer timeout;
+        timeout.setSingleShot(true);
+        QObject::connect(&timeout, SIGNAL(timeout()), &loop, SLOT(quit()));
+        timeout.start(60000);
+
+        QElapsedTimer timer;
+        timer.start();
+        kinect.calibrate();
+        if(!kinect.startKinect())
+        {
+            qDebug() << "Can't play" << _path << ":" << kinect.getStatutsDescription();
+            return false;
+        }
+        loop.exec();
+        timeout.stop();
+        if(!kinect.isCalibrated())
+        {
+            qDebug() << "The recording did not calibrate in 60 s";
+            return false;
+        }
+        qint64 calibration = timer.elapsed();
+
+        //Played until no new data came for a second
+        reader.reset();
+        timer.start();
+        QTimer watchdog;
+        watchdog.setInterval(100);
+        QObject::connect(&watchdog, &QTimer::timeout, [&]()
+        {
+            if(reader.idleTime() > 1000)
+                loop.quit();
+        });
+        watchdog.start();
+        loop.exec();
+        kinect.stopKinect();
+
+        //The hands are only published once calibrated, their age covers the playback only
+        const LatencyStats& age = kinect.getHandsAge();
+
+        qint64 played = qMax(Q_INT64_C(1), timer.elapsed()-reader.idleTime());
+        qDebug() << "Playback at speed" << _speed << ": calibrated in" << calibration << "ms";
+        qDebug() << "Hands frames read :" << age.count() << "in" << played << "ms," << age.count()*1000.0/played << "per second";
+        qDebug() << "getHandsPosition :" << reader.readCost().summary("us") << "|" << reader.count() << "calls";
+        qDebug() << "Hands age, from the arrival of the frame to the first read :" << age.summary("us");
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+    args.removeFirst();
+
+    int repeat = 5;
+    qreal speed = 1.0;
+    while(args.size() >= 2 && (args[0] == "--repeat" || args[0] == "--speed"))
+    {
+        if(args[0] == "--repeat")
+            repeat = qMax(1, args[1].toInt());
+        else
+            speed = qMax(0.0, args[1].toDouble());
+        args = args.mid(2);
+    }
+
+    SkeletonRecording recording;
+    std::vector<cv::Mat> frames;
+    if(args.size() >= 2 && args[0] == "--images")
+        frames = imageFrames(args.mid(1));
+    else if(args.size() == 1)
+    {
+        if(!recording.open(args[0]))
+        {
+            qDebug() << "Can't open the recording" << args[0];
+            return 1;
+        }
+        frames = recordedColorFrames(recording);
+    }
+    else
+    {
+        qDebug() << "Usage : Starfighter4KKinectBench [--repeat n] [--speed s] <recording> | --images <image>...";
+        return 1;
+    }
+
+    if(frames.empty())
+    {
+        qDebug() << "No color frame to calibrate on";
+        return 1;
+    }
+
+    qDebug() << frames.size() << "color frames," << repeat << "times";
+    bool success = benchCalibration(frames, repeat);
+
+    if(recording.isOpen())
+    {
+        success = benchLag(args[0], recording, frames) && success;
+        success = benchPlayback(args[0], speed) && success;
+    }
+    return success ? 0 : 1;
+}
@@ -15,6 +15,19 @@
 #define FONT_PATH							":/font/HelveticaNeueLight.ttf"
 #define NB_COUNTDOWN						3
 #define OFFSET_HUD							114
+#define RENDER_QUALITY_LEVELS               5
+#define RENDER_CONTROL_FRAMES               30 // frames between two quality evaluations
+#define RENDER_RECOVER_EVALS                4 // calm evaluations before the quality goes back up
+#define RENDER_OVERLOAD_RATIO               1.25 // measured frame period / timer period
+#define RENDER_RECOVER_RATIO                1.05
+#define RENDER_OVERLOAD_COST                0.6 // paint cost / timer period
+#define RENDER_IDLE_RATIO                   10 // longer gaps between two frames are pauses
+#define PROFILER_REFRESH                    30 // frames between two updates of the profiler overlay
+//GameEngine
+#define FRAME_ARENA_BLOCK_SIZE              16384 // (bytes), scratch memory of one tick
+#define MATCH_ARENA_CHUNK_SIZE              65536 // (bytes), entities of one match
+#define SPAWN_BUDGET_COUNT                  12 // items of a burst added per tick
+#define SPAWN_BUDGET_US                     2000 // (us), time given to the bursts per tick
 //SpawnEngine
 #define PROB_ASTEROID                       75
 #define PROB_ALIEN                          25
@@ -24,6 +37,17 @@
 #define PROB_BLACKSQUADRON                  5
 
 #define SPAWN_INTERVAL                      350 // (ms)
+#define SPAWN_CONTROL_TICKS                 60 // ticks between two load evaluations
+#define SPAWN_LOAD_LEVELS                   4
+#define SPAWN_OVERLOAD_RATIO                1.25 // measured frame period / timer period
+#define SPAWN_RECOVER_RATIO                 1.05
+#define SPAWN_OVERLOAD_COST                 0.75 // tick cost / timer period
+#define SPAWN_FACTOR_STEP                   0.2 // spawn probability lost per load level
+#define SPAWN_CAP_SATELLITES                1 // living items allowed once the category is shed
+#define SPAWN_CAP_SUPERNOVAE                0
+#define SPAWN_CAP_ASTEROIDS                 16
+#define SPAWN_CAP_ALIENS                    2
+#define SPAWN_CAP_BLACKSHIPS                5
 #define RESISTANCE_ASTEROID                 50
 #define RESISTANCE_ALIEN                    425
 #define ALIEN_SWIRL_MIN                     20
@@ -40,6 +64,10 @@
 #define REFRESH                             17 // (ms)
 #define NOVATIMER                           10000 // (ms)
 
+//KinectWindow
+#define MENU_DWELL_TICK                     50 // (ms) period of the clock that fills the buttons under a hand
+#define MENU_DWELL_STEPS                    30 // ticks of the clock before a button under a hand is clicked
+
 //AlienSpaceShip
 #define PICTURE_ALIENSPACESHIP              ":/images/game/mothership"
 #define PICTURE_ALIENSPACESHIP_SHADOW       ":/images/game/shadow"
@@ -89,15 +117,9 @@
 #define POWER_ALIEN                         3500
 #define MODULE_INCREMENT_ALIEN              4.0
 
-//ProjectileCross
-#define POWER_CROSS                         600
-#define SPEED_CROSS_DEF                     25 // dx
+//Cross shot, the power and speed of the straight-line projectiles are in LinearProjectile.cpp
 #define SLOPE_CROSS                         M_PI/16
 
-//ProjectileSimple
-#define POWER_SIMPLE                        1000
-#define SPEED_SIMPLE_DEF                    25 // dx
-
 //ProjectileV
 #define POWER_V                             1250
 #define SPEED_V_DEF                         25 // dx
@@ -109,6 +131,7 @@
 //ProjectileMulti
 #define POWER_MULTI                         800
 #define SPEED_MULTI_DEF                     25
+#define MULTI_POWER_TABLE_SIZE              256 // ticks of n^power kept per exponent
 
 //ProjectileGuided
 #define POWER_GUIDED                        1000000
@@ -151,8 +174,6 @@
 
 //BlackShip
 #define PICTURE_BLACKSHIP                   ":/images/game/blackship"
-#define POWER_BLACKSHIP_PROJECTILE          500
-#define SPEED_BLACKSHIP_PROJECTILE          30
 #define INTERVAL_ATTACK_DISTANCE_BLACKSHIP  8
 #define ANGLE_FIRST_BLACKSHIP_FIRE          20*M_PI/180.0
 #define ANGLE_SECOND_BLACKSHIP_FIRE         10*M_PI/180.0
@@ -176,6 +197,14 @@
 #define TRACKING_SOUND						"tracking.mp3"
 #define FREEZE_SOUND						"freeze.mp3"
 #define ANTIGRAVITY_SOUND					"antigravity.mp3"
+#define SOUND_NOTIFY_INTERVAL               5 // (ms), resolution of the trigger latency measure
+#define SOUND_NULL_PERIOD                   10 // (ms), buffer of the null sink, the latency it adds
+#define SOUND_NULL_VOICE_LENGTH             300 // (ms), silence played by the voices of the null sink
+
+//Sprites
+#define SPRITE_ARCHIVE                      "./sprites.pak" // Written by the build, Starfighter4K --pack-sprites <file>
+#define MENU_BACKGROUND                     ":/images/menu/background"
+#define SPRITE_ROTATION_BINS                128 // Pre-rotated images per sprite, rendered on first use
 
 //HUD
 #define IMAGE_BONUS_ANTIGRAVITY     ":/images/bonus/antiGravity"
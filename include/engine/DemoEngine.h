@@ -29,7 +29,6 @@ public:
 
 	void escapeGame(bool isKey = false);
 
-public slots:
     void elemenDestroyed(Destroyable* _destroyItem, int nbPoint, Shooter forShip);
 
 private:
@@ -18,6 +18,8 @@ class QPixmap;
 class QSplashScreen;
 class HUDWidget;
 class QGraphicsTextItem;
+class QGraphicsSimpleTextItem;
+class GameView;
 
 class DisplayEngine : public QMainWindow
 {
@@ -31,6 +33,7 @@ public:
     qreal xmaxWarZone() const;
 
     void addItemScene(Displayable* item);
+    void addLayerScene(QGraphicsItem* layer);
     void removeItemScene(Displayable* item);
 
     void updateGameData();
@@ -39,11 +42,18 @@ public:
     void explosionScreen();
     HUDWidget* getHud() { return hud; }
 
+	void newMatch();
+	void endMatch();
 	void startCountDown();
 
 	void showMessage(const QString&);
 	void removeMessage();
 
+    void setTargetPeriod(int _ms);
+
+    void startFirstFrameTimer();
+    qint64 firstFrameDelay() const;
+
 protected:
     void keyPressEvent(QKeyEvent *event);
     void closeEvent(QCloseEvent *event);
@@ -59,6 +69,9 @@ private slots:
 private:
     void creatHUD();
     void switchFullScreen();
+    void switchProfiler();
+    void switchPinnedQuality();
+    void updateProfiler();
 
     void setProgressHP1(int _value);
     void setProgressHP2(int _value);
@@ -74,7 +87,7 @@ private:
     QGraphicsPixmapItem* bgScene;
     QPixmap bg;
     QGraphicsScene * scene;
-    QGraphicsView * view;
+    GameView * view;
     qreal angleBg;
 
     QTime* affiche;
@@ -84,6 +97,16 @@ private:
 	int countDown;
     HUDWidget* hud;
 
+    //Last values sent to the HUD, the labels are only rebuilt when they change
+    int shownSeconds;
+    int shownScore1;
+    int shownScore2;
+
+    //Frame times and load levels, toggled with F3. F4 pins the quality levels one after the other
+    QGraphicsSimpleTextItem* profiler;
+    bool isProfilerShown;
+    int profilerFrames;
+
     bool isFullScreen;
 };
 #endif
@@ -3,6 +3,15 @@
 
 #include "include/enum/Enum.h"
 #include "include/config/Define.h"
+#include "include/utils/FrameArena.h"
+#include "include/utils/MatchArena.h"
+#include "include/game/ProjectileStore.h"
+#include "include/game/DeathQueue.h"
+#include "include/game/SpawnQueue.h"
+#include "include/engine/SpawnController.h"
+#include "include/utils/LatencyStats.h"
+
+#include <vector>
 
 class DisplayEngine;
 class UserControlsEngine;
@@ -23,15 +32,21 @@ class QWidget;
 class Blackship;
 class QKinect;
 
+typedef std::vector<Projectile*, FrameAllocator<Projectile*> > FrameProjectileList;
+
 class GameEngine : public QGraphicsView
 {
     Q_OBJECT
 
 public:	
-    GameEngine(WiimoteEngine* wiimoteEngine, QKinect* kinect, GameMode gameMode, int duration, SpaceshipType player1Ship, SpaceshipType player2Ship, TypeSpecialBonus sbp1, TypeSpecialBonus sbp2, int difficulty, QWidget*);
+    GameEngine(WiimoteEngine* wiimoteEngine, QKinect* kinect, QWidget* parent = 0);
     GameEngine(QWidget *parent = 0);
     virtual ~GameEngine();
 
+    //The engine (window, scene, sounds) lives as long as the menu, only the game state is rebuilt for each match
+    void newMatch(GameMode gameMode, int duration, SpaceshipType player1Ship, SpaceshipType player2Ship, TypeSpecialBonus sbp1, TypeSpecialBonus sbp2, int difficulty);
+    void endMatch();
+
     static double randDouble();
     static int randInt(int range);
 
@@ -52,11 +67,21 @@ public:
     UserControlsEngine* userControlsEngine() const {return uc;}
     WiimoteEngine* wiimoteEngine() const {return we;}
 	SpawnEngine* spawnEngine() const {return se;}
+    SpawnController& spawnController() {return spawnControl;}
+    FrameArena& tickArena() {return frameArena;}
+    MatchArena& matchArena() {return entityArena;}
+    DeathQueue& tickDeaths() {return deathQueue;}
     GameMode getGameMode() const {return gameMode;}
 
     bool getHasSomeonWon() const {return hasSomeoneWon;}
     virtual void timerEvent(QTimerEvent *);
 
+    int nbAlive(Difficulty _category) const;
+
+    //Bursts go through the spawn queue, see flushSpawns()
+    void spawnLater(Displayable* _item, SpawnQueue::Target _target);
+    void spawnLater(const SpawnQueue::Factory& _create, SpawnQueue::Target _target);
+
     virtual void addBlackship(Blackship* _blackship);
     virtual void addProjectile(Projectile *_inProjectile);
     virtual void addSupernova(Supernova *_inSupernova);
@@ -78,6 +103,8 @@ public:
     void enableAntiGravity(Shooter playerActivated);
     void freezePlayer(int duration, Shooter playerDest);
 
+    virtual void elemenDestroyed(Destroyable* destroyItem,int nbPoint,Shooter forShip);
+
 	void quitGame();
 
 	const static int offset = OFFSET_HUD;
@@ -86,7 +113,6 @@ signals:
     void signalPause(bool); // true = isPause
 
 public slots:
-    virtual void elemenDestroyed(Destroyable* destroyItem,int nbPoint,Shooter forShip);
 	void start();
 
 private slots:
@@ -95,11 +121,17 @@ private slots:
 
 protected:
     void checkOutsideScene(QList<Displayable*> &list);
+    void checkOutsideProjectiles();
+    bool isOutsideScene(const Displayable* item, const QRect& scene) const;
     void clearList(QList<Displayable*> &list);
+    void deleteList(QList<Displayable*> &list);
     bool checkCollisionItemAndList(const int i_list1,QList<Displayable*> &list1,QList<Displayable*> &list2);
     bool checkCollisionSpaceshipAndList(const int i_list1,QList<Displayable*> &list);
     void runTestCollision(QList<Displayable*> &list);
-    void detectObjectAfterMiddleZone(const QList<Displayable*>& list, QList<Projectile*>& projList, Shooter PlayerActivated);
+    void processDeaths();
+    void flushSpawns();
+    void discard(Displayable*& item);
+    void detectObjectAfterMiddleZone(const QList<Displayable*>& list, FrameProjectileList& projList, Shooter PlayerActivated);
 
     QMutex* mutex;
     QList<Displayable*>  listProjectile;
@@ -112,6 +144,18 @@ protected:
     QList<Displayable*>  listBlackship;
 
     SpawnEngine *se;
+    //Outlives the SpawnEngine of each match, so the load measured in a match carries over to the next
+    SpawnController spawnControl;
+
+    //Scratch memory for the current tick, rewound at the end of timerEvent()
+    FrameArena frameArena;
+    //Every Displayable of the match, given back at once when the engine is destroyed
+    MatchArena entityArena;
+    //Straight-line projectiles, moved and culled in one pass instead of by the scene
+    ProjectileStore projectileStore;
+    //Deaths, splinters and removed items of the tick, handled by processDeaths() once the collisions are done
+    DeathQueue deathQueue;
+    SpawnQueue spawnQueue;
 
 private:
     SoundEngine *soe;
@@ -136,5 +180,8 @@ private:
     // For elapsedTime()
     QElapsedTimer elapsedTimer;
     qint64 timeAlreadyCounted;
+
+    //Cost of moving the items in a tick (us), the scene's advance() and the ProjectileStore
+    LatencyStats moveCost;
 };
 #endif
@@ -0,0 +1,54 @@
+#ifndef GAME_VIEW_H
+#define GAME_VIEW_H
+
+#include "include/engine/RenderGovernor.h"
+#include "include/utils/LatencyStats.h"
+#include "include/config/Define.h"
+
+class QGLFramebufferObject;
+
+//View of the game scene whose render quality follows a RenderGovernor.
+//At the reduced scale levels the scene is drawn into a smaller framebuffer
+//object on the GPU, whose texture is then stretched over the viewport. The
+//HUD band is drawn again at native resolution on top so its text stays sharp.
+//The viewport must be a QGLWidget, the view stays at native scale otherwise.
+class GameView : public QGraphicsView
+{
+public:
+    GameView(QGraphicsScene* _scene, QWidget* _parent = 0);
+    ~GameView();
+
+    const RenderGovernor& governor() const {return renderGovernor;}
+    void setTargetPeriod(int _ms) {renderGovernor.setTargetPeriod(_ms);}
+    //-1 lets the governor choose again
+    void pinLevel(int _level);
+
+    //Time from startFirstFrameTimer() to the end of the next paint, -1 until it is painted
+    void startFirstFrameTimer();
+    qint64 firstFrameDelay() const {return firstFrame;}
+
+    //Frame period and paint cost of each quality level
+    void logStatistics() const;
+    void resetStatistics();
+
+protected:
+    void paintEvent(QPaintEvent* _event);
+
+private:
+    bool canScale();
+    void paintScaled();
+    void applyLevel();
+    void releaseBuffer();
+
+    RenderGovernor renderGovernor;
+    int appliedLevel;
+    QGLFramebufferObject* buffer;
+
+    QElapsedTimer firstFrameTimer;
+    qint64 firstFrame;
+
+    LatencyStats levelPeriod[RENDER_QUALITY_LEVELS];
+    LatencyStats levelCost[RENDER_QUALITY_LEVELS];
+};
+
+#endif // GAME_VIEW_H
@@ -0,0 +1,61 @@
+#ifndef NULLAUDIOSINK_H
+#define NULLAUDIOSINK_H
+
+#include <QObject>
+#include <QAudio>
+#include <QAudioFormat>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QTimer>
+
+class QIODevice;
+
+//Stands for a QAudioOutput when there is no audio device. It pulls the
+//samples of its source at the rate of the format, the first one one period
+//after start() like a device that fills its buffer, and reports what it has
+//played through notify() and processedUSecs(). A source that has less than
+//what is due without being at its end is an underrun.
+class NullAudioSink : public QObject
+{
+    Q_OBJECT
+
+public:
+    NullAudioSink(const QAudioFormat& _format, int _periodMs, QObject* _parent = 0);
+
+    void start(QIODevice* _source);
+    void stop();
+
+    qint64 processedUSecs() const;
+    //Since start(), like QAudioOutput::elapsedUSecs(). What is played is never ahead of it by less than a period
+    qint64 elapsedUSecs() const;
+    void setNotifyInterval(int _ms) {notifyInterval = _ms;}
+    QAudio::State state() const {return currentState;}
+    QAudio::Error error() const {return currentError;}
+
+signals:
+    void notify();
+    void stateChanged(QAudio::State);
+
+private slots:
+    void pull();
+
+private:
+    NullAudioSink(const NullAudioSink&);    // Don't Implement
+    void operator=(const NullAudioSink&);   // Don't implement
+
+    void setState(QAudio::State _state, QAudio::Error _error);
+
+    QAudioFormat format;
+    int period; //(ms)
+    QTimer timer;
+    QElapsedTimer clock; //Since start()
+    QIODevice* source;
+    QByteArray scratch; //One period, what is read is thrown away
+    qint64 processedBytes;
+    int notifyInterval; //(ms)
+    qint64 notified; //Intervals already notified
+    QAudio::State currentState;
+    QAudio::Error currentError;
+};
+
+#endif // NULLAUDIOSINK_H
@@ -0,0 +1,50 @@
+#ifndef RENDER_GOVERNOR_H
+#define RENDER_GOVERNOR_H
+
+//Chooses how expensive the rendering of the game may be from the measured
+//frames. The quality level goes from 0 (native resolution, every render
+//hint) to RENDER_QUALITY_LEVELS-1 (scene drawn in a half size buffer).
+//It rises as soon as one evaluation finds the frames too slow, but only
+//comes back down after RENDER_RECOVER_EVALS calm evaluations in a row.
+//A pinned level stays put whatever the frames measure, to compare two levels.
+class RenderGovernor
+{
+public:
+    RenderGovernor();
+
+    void setTargetPeriod(int _ms) {targetPeriod = _ms*1000.0;}
+
+    void frameStarted();
+    void frameFinished();
+
+    int level() const {return currentLevel;}
+    //-1 gives the level back to the measures
+    void pinLevel(int _level);
+    int pinnedLevel() const {return pinned;}
+    qreal scale() const;
+    QPainter::RenderHints renderHints() const;
+
+    qreal framePeriod() const {return averagePeriod/1000.0;}//(ms)
+    qreal frameCost() const {return averageCost/1000.0;}//(ms)
+    //Last frame only, the period is 0 after a pause
+    qint64 lastPeriod() const {return lastPeriodValue;}//(us)
+    qint64 lastCost() const {return lastCostValue;}//(us)
+
+private:
+    void evaluate();
+
+    QElapsedTimer periodClock;
+    QElapsedTimer costClock;
+
+    qreal targetPeriod;//(us)
+    qreal averagePeriod;//(us)
+    qreal averageCost;//(us)
+    int nbFrames;
+    int nbCalm;
+    int currentLevel;
+    int pinned;
+    qint64 lastPeriodValue;
+    qint64 lastCostValue;
+};
+
+#endif // RENDER_GOVERNOR_H
@@ -2,6 +2,9 @@
 #define SOUNDENGINE_H
 
 #include "include/enum/Enum.h"
+#include "include/utils/LatencyStats.h"
+
+class NullAudioSink;
 
 #define SAT_INTERVAL 1500
 
@@ -9,11 +12,28 @@ class SoundEngine : public QObject
 {
     Q_OBJECT
 public:
-    explicit SoundEngine(int soundEffectsVolume, int musicVolume, QObject *parent = 0);
-    
+    //Without audio output device, or when forceNullSink is set, the voices play in NullAudioSinks
+    explicit SoundEngine(int soundEffectsVolume, int musicVolume, QObject *parent = 0, bool forceNullSink = false);
+    ~SoundEngine();
+
+    bool isNullSink() const {return nullSink;}
+    const LatencyStats& triggerLatency() const {return latency;}
+    int underrunCount() const {return underruns;}
+    void resetStatistics();
+    void logStatistics() const;
+
+    void setVolumes(int soundEffectsVolume, int musicVolume);
+    void startMusic();
+    void stopMusic();
+
 signals:
 
 private:
+    QMediaPlayer* createVoice(const QString& file, int volume);
+    QMediaPlayer* voice(Sounds) const;
+    void trigger(QMediaPlayer* player);
+    void voiceStarted(QObject* voice, qint64 position);
+
     QMediaPlayer *satMediaPlayer;
     QMediaPlayer *shootMediaPlayer;
     QMediaPlayer *snovaMediaPlayer;
@@ -22,9 +42,31 @@ private:
 	QMediaPlayer *freezeMediaPlayer;
 	QMediaPlayer *trackingMediaPlayer;
 
+    //Silent voice of the null sink, the sink pulls it at the rate of a device
+    struct NullVoice
+    {
+        NullAudioSink* sink;
+        QBuffer* source;
+    };
+
+    //Latency between playSound() and the first sample played by the voice (us)
+    bool nullSink;
+    QByteArray nullSamples;
+    QHash<QMediaPlayer*, NullVoice> nullVoices;
+    QElapsedTimer clock;
+    QHash<QObject*, qint64> pendingTriggers; //By QMediaPlayer, or by NullAudioSink with the null sink
+    LatencyStats latency;
+    int underruns;
+
 public slots:
     void playSound(Sounds);
 	void stopSound(Sounds);
+
+private slots:
+    void voicePositionChanged(qint64 position);
+    void voiceStatusChanged(QMediaPlayer::MediaStatus status);
+    void nullVoiceNotify();
+    void nullVoiceStateChanged(QAudio::State state);
     
 };
 
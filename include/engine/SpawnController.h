@@ -0,0 +1,48 @@
+#ifndef SPAWN_CONTROLLER_H
+#define SPAWN_CONTROLLER_H
+
+#include "include/enum/Enum.h"
+
+//Watches how long the ticks of the game really take and sheds spawning when
+//the machine does not keep up. The load level (0 to SPAWN_LOAD_LEVELS-1)
+//moves by one step at most every SPAWN_CONTROL_TICKS ticks, with a wide gap
+//between the overload and the recovery thresholds so it does not oscillate.
+//Each level lowers the spawn probability, and once a category's rank is
+//reached it can't spawn while it already has its cap of living items: the
+//satellites and the supernovae go first, the shooting enemies last.
+class SpawnController
+{
+public:
+    SpawnController();
+
+    void setTargetPeriod(int _ms) {targetPeriod = _ms*1000.0;}
+
+    void tickStarted();
+    void tickFinished();
+    //After a pause the next period is not a measure
+    void pause();
+
+    int loadLevel() const {return level;}
+    qreal spawnFactor() const;
+    bool allows(Difficulty _category, int _nbAlive);
+
+private:
+    static const int kNbCategories = 5;
+
+    void evaluate();
+    //Rejections since the last report, as text for the log, then starts counting again
+    QString takeRejections();
+
+    QElapsedTimer periodClock;
+    QElapsedTimer costClock;
+
+    qreal targetPeriod;//(us)
+    qreal averagePeriod;//(us)
+    qreal averageCost;//(us)
+    int nbTicks;
+    int level;
+    //Per category, in the order of the limits table, reported with the level changes and the pauses
+    int rejections[kNbCategories];
+};
+
+#endif // SPAWN_CONTROLLER_H
@@ -4,6 +4,7 @@
 #include "include/config/Define.h"
 
 class GameEngine;
+class SpawnController;
 class DisplayEngine;
 class QTimer;
 class Bonus;
@@ -35,6 +36,7 @@ private:
     bool spawnBlackSquadron;
 
     QTimer *timer;
+    SpawnController& spawnController;//Owned by the GameEngine
 
     const static int kProbAsteroid = PROB_ASTEROID;
     const static int kProbAlien = PROB_ALIEN;
@@ -15,6 +15,7 @@
 
 #include "include/enum/Enum.h"
 #include "include/config/Define.h"
+#include "include/utils/StepRotation.h"
 
 class GameEngine;
 
@@ -29,6 +30,8 @@ public:
     void paint(QPainter *_painter, const QStyleOptionGraphicsItem *, QWidget *);
 	void turnShadow();
     TypeItem getTypeObject() const {return tAlien;}
+    bool isDying() const {return Destroyable::isDying();}
+    Destroyable* destroyable() {return this;}
 private:
     void advance(int _step);
     void attacking();
@@ -47,6 +50,7 @@ private:
     qreal dModule;
     qreal dX0;
     qreal dY0;
+    StepRotation arc;
     int yStop;
     qreal blink;
     bool raisingEdge;
@@ -17,6 +17,7 @@
 #include "include/config/Define.h"
 
 class GameEngine;
+struct SplinterEvent;
 
 class Asteroid : public Destroyable, public Projectile
 {
@@ -27,11 +28,14 @@ public:
     bool isSmall() const {return bSmall;}
     int getIdParent() const {return idParent;}
     TypeItem getTypeObject() const {return (bSmall)?tSmallAsteroid:tAsteroid;}
+    bool isDying() const {return Destroyable::isDying();}
+    Destroyable* destroyable() {return this;}
     QRectF boundingRect() const;
     QPainterPath shape() const;
     virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *);
 
     void collision(qreal _dAngle);
+    static void createSplinters(GameEngine* _gameEngine, const SplinterEvent& _event);
 
 protected:
     int currentFrame;
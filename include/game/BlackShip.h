@@ -20,6 +20,8 @@ public:
     void paint(QPainter *_painter, const QStyleOptionGraphicsItem *, QWidget *);
 
     TypeItem getTypeObject() const {return tBlackShip;}
+    bool isDying() const {return Destroyable::isDying();}
+    Destroyable* destroyable() {return this;}
 
     static void createBlackSquadron(GameEngine *gameEngine);
 
@@ -13,6 +13,7 @@
 #include "include/game/Displayable.h"
 
 #include "include/config/Define.h"
+#include "include/utils/StepRotation.h"
 
 class GameEngine;
 
@@ -41,6 +42,7 @@ private:
     qreal dModule;
     qreal dX0;
     qreal dY0;
+    StepRotation arc;
     int k;
     int directionX;
     int directionY;
@@ -0,0 +1,63 @@
+#ifndef DEATHQUEUE_H
+#define DEATHQUEUE_H
+
+#include "include/enum/Enum.h"
+
+#include <QVector>
+#include <QPointF>
+
+class Destroyable;
+class Displayable;
+
+struct DeathEvent
+{
+    Destroyable* item;
+    int nbPoint;
+    Shooter forShip;
+};
+
+//Splinters of a big asteroid, see Asteroid::collision()
+struct SplinterEvent
+{
+    QPointF centre;
+    qreal parentAngle;
+    qreal hitAngle;
+    qreal speed;
+};
+
+//Consequences of the current tick. The entities write their death into it
+//instead of emitting a signal, the collisions their splinters and the items
+//they take out of the game. The engine handles everything in one pass once
+//the collisions have been checked, so no list changes while it is walked.
+class DeathQueue
+{
+public:
+    DeathQueue() {}
+
+    void push(Destroyable* _item, int _nbPoint, Shooter _forShip);
+    //An item deleted before the queue is drained leaves a hole instead of a dangling pointer
+    void cancel(Destroyable* _item);
+    void pushSplinters(const SplinterEvent& _event) {splinters.append(_event);}
+    //The item must already be out of the engine's lists, it is deleted when the queue is drained
+    void discard(Displayable* _item) {graveyard.append(_item);}
+    void clear();
+
+    //Events can be pushed while the queue is walked, size() must be read at each iteration
+    int size() const {return events.size();}
+    const DeathEvent& at(int _i) const {return events.at(_i);}
+
+    int nbSplinters() const {return splinters.size();}
+    const SplinterEvent& splinterAt(int _i) const {return splinters.at(_i);}
+
+    const QVector<Displayable*>& discarded() const {return graveyard;}
+
+private:
+    DeathQueue(const DeathQueue&);      // Don't Implement
+    void operator=(const DeathQueue&);  // Don't implement
+
+    QVector<DeathEvent> events;
+    QVector<SplinterEvent> splinters;
+    QVector<Displayable*> graveyard;
+};
+
+#endif // DEATHQUEUE_H
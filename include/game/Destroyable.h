@@ -12,18 +12,25 @@
 
 #include "include/enum/Enum.h"
 
-class Destroyable : public QObject
+class DeathQueue;
+
+//Not a QObject: a death is written to the engine's DeathQueue, there is no signal to connect per entity
+class Destroyable
 {
-    Q_OBJECT
 public:
     Destroyable(qreal _dHealthPoint,qreal _dResistance);
-    virtual ~Destroyable() {}
+    virtual ~Destroyable();
 
     virtual void receiveAttack(qreal _dPower,int _point,Shooter _forShip);
     bool gonnaDead(qreal _dPower);
 
-signals:
-    void destroyed(Destroyable* _destroyItem,int _nbPoint,Shooter _forShip);
+    //The tag of Displayable::getTypeObject(), an entity's override is the same for both bases.
+    //The engine dispatches a death on it instead of trying each type with dynamic_cast
+    virtual TypeItem getTypeObject() const=0;
+
+    void setDeathQueue(DeathQueue* _deathQueue) {deathQueue = _deathQueue;}
+    //Dead but still waiting for the engine to remove it
+    bool isDying() const {return bDying;}
 
 protected:
     void isDead();
@@ -32,5 +39,9 @@ protected:
     qreal dResistance;
     int pointToGive;
     Shooter forShip;
+
+private:
+    DeathQueue* deathQueue;
+    bool bDying;
 };
 #endif
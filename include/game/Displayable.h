@@ -13,20 +13,33 @@
 #include "include/enum/Enum.h"
 
 class QPixmap;
+class MatchArena;
+class Destroyable;
 
 class Displayable : public QGraphicsItem
 {
 public:
-    Displayable(qreal _dX, qreal _dY, QPixmap* _pixmap = 0);
+    //The picture belongs to the SpriteCache, the entity only points to it
+    Displayable(qreal _dX, qreal _dY, const QPixmap* _pixmap = 0);
     virtual ~Displayable();
 
+    //Entities of a match live in its arena : new (gameEngine->matchArena()) Asteroid(...)
+    static void* operator new(size_t _size, MatchArena& _arena);
+    static void* operator new(size_t _size);
+    static void operator delete(void* _p, MatchArena& _arena);
+    static void operator delete(void* _p);
+
     QSize sizePixmap() const {return isPixmap()?pxmPicture->size():QSize();}  
     int getNbPoint() const {return nbPoint;}
-    QPixmap* getPixmap() const {return pxmPicture;}
+    const QPixmap* getPixmap() const {return pxmPicture;}
     bool isPixmap() const {return !pxmPicture==0;}
 
     virtual TypeItem getTypeObject() const=0;
     virtual qreal getPower() const {return 0.0;}
+    //Dead but still waiting for the engine to remove it, only a Destroyable can die
+    virtual bool isDying() const {return false;}
+    //The health of the entity, 0 if it can't be destroyed (no cross cast in the collisions)
+    virtual Destroyable* destroyable() {return 0;}
     virtual void advance(int _step)=0;
 
     qreal getAngle() const {return dAngle;}
@@ -37,14 +50,39 @@ public:
 
 
     void setPos(qreal _dX, qreal _dY);
-    virtual void setPixmap(QPixmap* _pxmPixmap);
+    virtual void setPixmap(const QPixmap* _pxmPixmap);
 
 protected:
+    QPainterPath ellipseShape(const QRectF& _rect) const;
+    //The ellipse of a rect of the sprite, carried by spriteTransform() like the item transform did
+    QPainterPath spriteEllipseShape(const QRectF& _spriteRect) const;
+
+    //Same meaning as QGraphicsItem::setRotation() and setTransform(), but the item keeps an identity
+    //transform and drawSprite() blits a pre-rotated sprite of the SpriteCache instead of
+    //transforming the pixmap at each paint. boundingRect() must be mapped by spriteTransform().
+    //Only rotations and translations : the blit has no scale, mirror or shear
+    void setSpriteRotation(qreal _degrees);
+    void setSpriteTransform(const QTransform& _transform);
+    const QTransform& spriteTransform() const {return spriteMatrix;}
+    void drawSprite(QPainter* _painter, const QPixmap& _sprite) const;
+    //What drawSprite() blits : the pre-rotated sprite, and its top left corner in _topLeft
+    const QPixmap& spriteBlit(const QPixmap& _sprite, QPointF& _topLeft) const;
+
     int nbPoint;
     qreal dAngle;
 private:
     qreal dX;
     qreal dY;
-    QPixmap* pxmPicture;
+    const QPixmap* pxmPicture;
+
+    //Combined like in QGraphicsItem : base transform, then rotation around the origin
+    QTransform spriteBase;
+    qreal spriteAngle;
+    QTransform spriteMatrix;
+
+    //shape() is called for every collision test of every tick, the path is only rebuilt when the rect changes
+    mutable QPainterPath shapePath;
+    mutable QRectF shapeRect;
+    mutable QTransform shapeMatrix;
 };
 #endif
@@ -0,0 +1,34 @@
+#ifndef LINEARPROJECTILE_H
+#define LINEARPROJECTILE_H
+
+#include "include/game/Projectile.h"
+
+//The straight-line projectiles, one row each in LinearProjectile::parameters()
+enum LinearKind
+{
+    SimpleKind, CrossKind, BlackKind, NbLinearKinds
+};
+
+struct LinearKindParameters
+{
+    qreal power;
+    qreal speed;
+    bool mirrored;  //Player2 shoots towards the left
+};
+
+//Projectile flying straight at a constant speed. Everything that differs from
+//one kind to another is its row of the table, the motion is the ProjectileStore's,
+//so a new kind only needs an enum value and a row : neither the engines nor the
+//collisions have to know about it.
+class LinearProjectile : public Projectile
+{
+public:
+    LinearProjectile(LinearKind _kind, qreal _dXOrigin, qreal _dYOrigin, Shooter _from, qreal _dAngle);
+    ~LinearProjectile() {}
+
+    static const LinearKindParameters& parameters(LinearKind _kind);
+
+    bool hasLinearMotion() const {return true;}
+};
+
+#endif // LINEARPROJECTILE_H
@@ -14,7 +14,7 @@
 
 #include "include/enum/Enum.h"
 
-class QColor;
+class ProjectileStore;
 
 class Projectile : public Displayable
 {
@@ -31,6 +31,10 @@ public:
 
     virtual void enableAntiGravity(Shooter playerActivated);
 
+    //True when advance() is a constant step, the projectile can then be moved and drawn by a ProjectileStore
+    virtual bool hasLinearMotion() const {return false;}
+    virtual QPointF velocity() const;
+
     QRectF boundingRect() const;
     QPainterPath shape() const;
     void paint(QPainter *_painter, const QStyleOptionGraphicsItem *, QWidget *);
@@ -45,9 +49,15 @@ protected:
     bool antiGravity;
 
     qreal dSpeed;
-    QColor* color;
-    QPixmap* image;
+    QColor color;
+    const QPixmap* image;//In the SpriteCache
 
     Shooter from;
+
+private:
+    friend class ProjectileStore;
+
+    ProjectileStore* store;
+    int storeSlot;
 };
 #endif
@@ -19,11 +19,16 @@ public:
     ProjectileAlien(qreal _dXOrigin, qreal _dYOrigin,Shooter _from, qreal _dArgument, qreal _dModule);
     ~ProjectileAlien() {}
 
+    bool hasLinearMotion() const {return antiGravity;}
+    QPointF velocity() const;
+
 private:
     static const qreal kIntervalModule;
 
     void advance(int _step);
 
     qreal dModule;
+    qreal cosAngle;
+    qreal sinAngle;
 };
 #endif
@@ -2,6 +2,7 @@
 #define PROJECTILEMULTI_H
 
 #include "Projectile.h"
+#include "include/utils/PowerSteps.h"
 
 class ProjectileMulti : public Projectile
 {
@@ -9,11 +10,18 @@ public:
     ProjectileMulti(qreal _dXOrigin, qreal _dYOrigin, Shooter _from, qreal _coeff, qreal _power, qreal _dAngle);
     ~ProjectileMulti() {}
 
+    bool hasLinearMotion() const {return antiGravity;}
+
 private:
     void advance(int _step);
 
     qreal power;
     qreal coeff;
+
+    qreal stepX;
+    qreal scale;
+    int nbSteps;
+    PowerSteps powers;
 };
 
 #endif // PROJECTILEMULTI_H
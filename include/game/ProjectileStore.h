@@ -0,0 +1,87 @@
+#ifndef PROJECTILESTORE_H
+#define PROJECTILESTORE_H
+
+#include "include/enum/Enum.h"
+
+#include <QVector>
+#include <QPointF>
+
+class Projectile;
+class ProjectileLayer;
+class QGraphicsItem;
+class QPixmap;
+class QPainter;
+
+//State of the projectiles flying in a straight line, kept as one array per
+//field so the integration and the off-screen test run over packed data (two
+//lanes at a time with SSE2) instead of one virtual advance() per item.
+//A stored projectile is not in the scene : the scene neither advances it nor
+//tracks its position, the layer item draws all of them in one paint() from
+//the sprite arrays. The item itself is still the one the collisions test,
+//its position is written back after each step (cheap outside of a scene).
+class ProjectileStore
+{
+public:
+    ProjectileStore();
+    ~ProjectileStore();
+
+    //The item to add to the scene for the stored projectiles to be drawn, owned by the scene.
+    //It can be deleted with the scene items at the end of a match, the next one creates another
+    QGraphicsItem* createLayer();
+
+    //The projectile must not be in a scene, the engines insert it instead of adding it
+    void insert(Projectile* _projectile);
+    void remove(Projectile* _projectile);
+    //To call when the motion or the sprite of a projectile has changed (anti-gravity).
+    //A projectile that becomes linear is taken out of the scene
+    void update(Projectile* _projectile);
+
+    void advance();
+    //Flags the projectiles outside [0,_width]x[-_offset,_height], see GameEngine::checkOutsideScene()
+    void cull(qreal _width, qreal _height, qreal _offset);
+    bool isCulled(const Projectile* _projectile) const;
+
+    bool contains(const Projectile* _projectile) const;
+
+    //Appends the stored projectiles beyond _middle for anti-gravity of _player
+    //(left of it for Player1, right for Player2), shot by the other player
+    template<class List>
+    void collectBeyond(qreal _middle, Shooter _player, List& _list) const;
+
+    int size() const {return items.size();}
+
+private:
+    ProjectileStore(const ProjectileStore&);      // Don't Implement
+    void operator=(const ProjectileStore&);       // Don't implement
+
+    friend class ProjectileLayer;
+
+    void loadSprite(int _slot);
+    void paint(QPainter* _painter) const;
+
+    QVector<Projectile*> items;
+    QVector<qreal> xs;
+    QVector<qreal> ys;
+    QVector<qreal> vxs;
+    QVector<qreal> vys;
+    QVector<qreal> widths;
+    QVector<qreal> heights;
+    QVector<Shooter> owners;
+    //Pre-rotated sprite of the SpriteCache and its top left corner from the position
+    QVector<const QPixmap*> sprites;
+    QVector<QPointF> spriteOffsets;
+    QVector<uchar> culled;
+
+    ProjectileLayer* layer;
+};
+
+template<class List>
+void ProjectileStore::collectBeyond(qreal _middle, Shooter _player, List& _list) const
+{
+    int l_n = items.size();
+    for(int i = 0;i<l_n;i++)
+        if(owners[i] != _player && (_player == Player1 ? xs[i] < _middle : xs[i] > _middle))
+            _list.push_back(items[i]);
+}
+
+#endif // PROJECTILESTORE_H
@@ -11,6 +11,7 @@
 #define PROJECTILE_V_H
 
 #include "include/game/Projectile.h"
+#include "include/utils/StepRotation.h"
 
 class ProjectileV : public Projectile
 {
@@ -18,10 +19,14 @@ public:
     ProjectileV(qreal _dXOrigin, qreal _dYOrigin, Shooter _from, qreal _dAmpli, qreal _dOmega, qreal _dAngle);
     ~ProjectileV() {}
 
+    bool hasLinearMotion() const {return antiGravity;}
+
 private:
     void advance(int _step);
     qreal dAmplitude;
     qreal dOmega;
     qreal dAngle2;
+    qreal stepX;
+    StepRotation phase;
 };
 #endif
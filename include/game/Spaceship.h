@@ -22,7 +22,7 @@ class SpecialBonus;
 class ProjectileGuided;
 class HUDWidget;
 
-class Spaceship : public Destroyable, public Displayable
+class Spaceship : public QObject, public Destroyable, public Displayable
 {
     Q_OBJECT
 public:
@@ -35,6 +35,8 @@ public:
     void bottom();
 
     TypeItem getTypeObject() const {return tSpaceship;}
+    bool isDying() const {return Destroyable::isDying();}
+    Destroyable* destroyable() {return this;}
     Shooter getPlayer() const {return player;}
     QString getPlayerName() const {return playerName;}
     qreal getHealthPoint() const {return dHealthPoint;}
@@ -53,7 +55,7 @@ public:
 
 	void setY(int _y);
 
-    void setPixmap(QPixmap* _pxmPixmap);
+    void setPixmap(const QPixmap* _pxmPixmap);
     void addBonus(Bonus* _bonus);
     QRectF boundingRect() const;
     QPainterPath shape() const;
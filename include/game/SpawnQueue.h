@@ -0,0 +1,62 @@
+#ifndef SPAWNQUEUE_H
+#define SPAWNQUEUE_H
+
+#include "include/utils/LatencyStats.h"
+
+#include <QVector>
+#include <functional>
+
+class Displayable;
+
+//Items of a burst (supernova, alien attack, black squadron) waiting to enter
+//the game. The engine adds a few of them at the start of each tick, within
+//SPAWN_BUDGET_COUNT items and SPAWN_BUDGET_US microseconds, and moves the
+//late ones by the ticks they have waited so the burst looks the same.
+//An item can also be queued as the function that builds it, it is then built
+//when it enters the game and its construction is part of that tick's cost.
+class SpawnQueue
+{
+public:
+    enum Target
+    {
+        ToAsteroids, ToProjectiles, ToBlackships
+    };
+
+    typedef std::function<Displayable*()> Factory;
+
+    struct Pending
+    {
+        Displayable* item;  //0 until create() has built it
+        Factory create;
+        Target target;
+        int tick;
+    };
+
+    SpawnQueue();
+
+    void push(Displayable* _item, Target _target);
+    void push(const Factory& _create, Target _target);
+    bool isEmpty() const {return head == pending.size();}
+    Pending takeFirst() {return pending.at(head++);}
+    int ticksWaited(const Pending& _pending) const {return tick-_pending.tick;}
+
+    //Closes the tick, _cost is what the items added during it have cost
+    void endTick(int _nbSpawned, qint64 _cost);
+    //Deletes the items that never entered the game, the ones not built yet never will be
+    void discardAll();
+
+    //Cost of the ticks that have added something (us)
+    const LatencyStats& tickCost() const {return cost;}
+
+private:
+    SpawnQueue(const SpawnQueue&);      // Don't Implement
+    void operator=(const SpawnQueue&);  // Don't implement
+
+    QVector<Pending> pending;
+    int head;
+    int tick;
+
+    LatencyStats cost;
+};
+
+#endif // SPAWNQUEUE_H
@@ -19,7 +19,10 @@ class Supernova
 {
 public:
     Supernova(qreal _dX, qreal _dY,GameEngine *_gameEngine);
-    ~Supernova();
+    ~Supernova() {}
+
+    //Queues the flash and the asteroids, called by the engine with the other consequences of the tick
+    void explode();
 
     TypeItem getTypeObject() const {return tSupernova;}
 
@@ -0,0 +1,43 @@
+#ifndef HAND_FILTER_H
+#define HAND_FILTER_H
+
+#include <QPointF>
+
+//One-Euro filter on a hand position, followed by a short prediction.
+//The cutoff frequency rises with the speed of the hand : a hand at rest is
+//smoothed a lot (no jitter), a moving hand almost not (little lag). The
+//filtered speed then extrapolates the position kPrediction ahead, which
+//takes back part of the latency of the sensor.
+class HandFilter
+{
+public:
+	struct Parameters
+	{
+		Parameters() :minCutoff(1.0),beta(0.004),derivativeCutoff(1.0),prediction(0.04) {}
+
+		qreal minCutoff; //(Hz) cutoff of a hand at rest
+		qreal beta; //(s/px) growth of the cutoff with the speed
+		qreal derivativeCutoff; //(Hz) cutoff of the speed estimate
+		qreal prediction; //(s) how far ahead the position is extrapolated
+	};
+
+	HandFilter();
+
+	void setParameters(const Parameters& _parameters) {parameters = _parameters;}
+	const Parameters& getParameters() const {return parameters;}
+
+	//_dt (s) since the previous sample, returns the predicted position
+	QPointF filter(const QPointF& _position, qreal _dt);
+	//The hand is lost, the next sample starts again from scratch
+	void reset() {initialised = false;}
+
+private:
+	static qreal smoothing(qreal _cutoff, qreal _dt);
+
+	Parameters parameters;
+	bool initialised;
+	QPointF position;
+	QPointF speed; //(px/s)
+};
+
+#endif // HAND_FILTER_H
@@ -0,0 +1,46 @@
+#ifndef KINECT_SENSOR_H
+#define KINECT_SENSOR_H
+
+#include "SkeletonFrame.h"
+#include "opencv2/core/core.hpp"
+
+#include <QString>
+
+//What QKinect needs from a sensor. NuiKinectSensor drives a real Kinect
+//through the SDK, any other implementation (a recorded stream for example)
+//goes through exactly the same acquisition path.
+class KinectSensor
+{
+public:
+	enum Stream
+	{
+		NoStream = 0, SkeletonStream = 1, ColorStream = 2
+	};
+
+	virtual ~KinectSensor() {}
+
+	virtual bool isAvailable() const = 0;
+	virtual int sensorCount() const = 0;
+	//Opens the sensor and its streams, _report receives what happened
+	virtual bool open(QString& _report) = 0;
+	virtual void close() = 0;
+	virtual bool isWorking() const = 0;
+	virtual QString statusDescription() const = 0;
+	virtual void setElevationAngle(int _angle) = 0;
+
+	//Blocks until a stream has a new frame, returns the Stream flags of the
+	//ready ones (NoStream after _timeout ms). Every ready stream must be read
+	virtual int waitForFrames(int _timeout) = 0;
+	virtual bool readSkeletons(SkeletonFrame& _frame) = 0;
+	//The data stays valid until unlockColor()
+	virtual const uchar* lockColor(unsigned long& _size) = 0;
+	virtual void unlockColor() = 0;
+	//Releases the color stream for the rest of the session, only the skeleton
+	//stream stays configured on the sensor
+	virtual void closeColor() = 0;
+
+	//Projection of a joint in the 320x240 depth image
+	virtual cv::Point2f toDepthImage(const JointPosition& _joint) const = 0;
+};
+
+#endif // KINECT_SENSOR_H
@@ -0,0 +1,48 @@
+#ifndef NUI_KINECT_SENSOR_H
+#define NUI_KINECT_SENSOR_H
+
+#include "KinectSensor.h"
+
+#include <basetyps.h>
+#include <WTypes.h>
+#include <Windows.h>
+#include <NuiApi.h>
+
+//Kinect for Windows SDK implementation of KinectSensor, the streams signal
+//their frames through events and waitForFrames() sleeps on them
+class NuiKinectSensor : public KinectSensor
+{
+public:
+	NuiKinectSensor();
+	~NuiKinectSensor();
+
+	bool isAvailable() const;
+	int sensorCount() const;
+	bool open(QString& _report);
+	void close();
+	bool isWorking() const;
+	QString statusDescription() const;
+	void setElevationAngle(int _angle);
+
+	int waitForFrames(int _timeout);
+	bool readSkeletons(SkeletonFrame& _frame);
+	const uchar* lockColor(unsigned long& _size);
+	void unlockColor();
+	void closeColor();
+
+	cv::Point2f toDepthImage(const JointPosition& _joint) const;
+
+private:
+	NuiKinectSensor(const NuiKinectSensor&);      // Don't Implement
+	void operator=(const NuiKinectSensor&);       // Don't implement
+
+	INuiSensor* m_kinect;
+
+	HANDLE m_pColorStreamHandle;
+	HANDLE m_hNextColorFrameEvent;
+	NUI_IMAGE_FRAME m_colorFrame; //Locked between lockColor() and unlockColor()
+
+	HANDLE m_hNextSkeletonEvent;
+};
+
+#endif // NUI_KINECT_SENSOR_H
@@ -0,0 +1,56 @@
+#ifndef RECORDED_KINECT_SENSOR_H
+#define RECORDED_KINECT_SENSOR_H
+
+#include "KinectSensor.h"
+#include "SkeletonRecording.h"
+
+#include <QElapsedTimer>
+
+//Plays a SkeletonRecording through the same path as a real Kinect, on any
+//platform. The skeleton frames come at their recorded pace divided by the
+//speed (0 : as fast as they are read). The color stream acts like a camera
+//filming still : it delivers the last recorded color frame every
+//kColorPeriod ms until it is closed, so the calibration can be asked at any time.
+class RecordedKinectSensor : public KinectSensor
+{
+public:
+	RecordedKinectSensor(const QString& _path, qreal _speed = 1.0);
+
+	bool isAvailable() const;
+	int sensorCount() const;
+	bool open(QString& _report);
+	void close();
+	bool isWorking() const;
+	QString statusDescription() const;
+	void setElevationAngle(int) {}
+
+	int waitForFrames(int _timeout);
+	bool readSkeletons(SkeletonFrame& _frame);
+	const uchar* lockColor(unsigned long& _size);
+	void unlockColor() {}
+	void closeColor() {colorOpen = false;}
+
+	cv::Point2f toDepthImage(const JointPosition& _joint) const;
+
+	//Goes on from the first frame recorded at or after _arrival (us)
+	void seek(qint64 _arrival);
+
+private:
+	static const int kColorPeriod = 33; //(ms)
+
+	int nextSkeleton(int _from) const;
+	qint64 dueTime(int _frame) const;
+
+	QString path;
+	qreal speed;
+	SkeletonRecording recording;
+	QElapsedTimer clock;
+	qint64 startArrival; //(us) recorded arrival played at the start of the clock
+	int cursor; //next skeleton frame
+	int firstColor;
+	int lastColor; //last color frame reached by the cursor
+	bool colorOpen;
+	qint64 nextColor; //(ms) on the clock
+};
+
+#endif // RECORDED_KINECT_SENSOR_H
@@ -5,23 +5,45 @@
 #include <vector>
 #include <array>
 
+//Each image is searched as soon as it is added and only its corners are kept.
+//The estimate is the median of every coordinate, it is stable once there are
+//kMinSquares squares and the central half of each coordinate is within
+//kTolerance pixels of its median. After kMaxImages images it is taken anyway.
 class RectangleDetection
 {
 public:
 	RectangleDetection(int _thresh = 50, int _N = 11);
 	void addImage(const cv::Mat& image);
+	//Top left, top right, bottom right, bottom left
+	//Median of each corner, in the order of orderCorners()
 	std::array<cv::Point, 4> getPoints();
-	size_t getSizeImages() const {return images.size();}
+	int getSizeImages() const {return nbImages;}
+	bool isStable() const {return stable;}
+	bool isDone() const;
 
 private:
-	std::vector<cv::Mat> images;
-	std::vector<std::vector<std::vector<cv::Point>>> points;
+	static const size_t kMinSquares = 5;
+	static const int kMaxImages = 30;
+	static const int kTolerance = 2;// (pixels)
+
+	void updateEstimate();
+
+	std::vector<int> coordinates[8];//x0 y0 x1 y1 ...
+	int median[8];
+	int nbImages;
+	bool stable;
 	int thresh;
 	int N;
 };
 
 double angle(cv::Point pt1, cv::Point pt2, cv::Point pt0 );
 bool findSquares(const cv::Mat& image, std::vector<std::vector<cv::Point> >& squares, int thresh, int N);
+//Same contract as findSquares, the threshold levels are searched in parallel on
+//a 1/4 scale pyramid level (1/2 if it finds nothing), then the corners are refined
+//at full resolution in a small window around each of them
+bool findSquaresPyramid(const cv::Mat& image, std::vector<std::vector<cv::Point> >& squares);
 void findLargestSquare(std::vector<std::vector<cv::Point> >& squares);
+//The 4 corners of a square in a fixed order : top left, top right, bottom right, bottom left
+std::array<cv::Point, 4> orderCorners(const std::vector<cv::Point>& square);
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
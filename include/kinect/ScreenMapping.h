@@ -0,0 +1,37 @@
+#ifndef SCREEN_MAPPING_H
+#define SCREEN_MAPPING_H
+
+#include "opencv2/core/core.hpp"
+#include <array>
+#include <vector>
+
+//Perspective mapping from the depth image of the Kinect (320x240) to the
+//green screen found by the calibration. The homography is computed once and
+//sampled every kStep depth pixels, a point is then mapped with a fetch of
+//the four surrounding nodes and a bilinear interpolation.
+//The result is normalised : (0,0) is the top left corner of the screen and
+//(1,1) the bottom right one.
+class ScreenMapping
+{
+public:
+	static const int kGridWidth = 320;
+	static const int kGridHeight = 240;
+
+	ScreenMapping();
+
+	//The corners are in the color image, _scale brings them to the depth image.
+	//They come top left, top right, bottom right, bottom left, as orderCorners() gives them
+	void calibrate(const std::array<cv::Point, 4>& _corners, double _scale);
+	bool isValid() const {return !table.empty();}
+
+	cv::Point2f map(float _x, float _y) const;
+
+private:
+	static const int kStep = 8;
+	static const int kColumns = kGridWidth/kStep+1;
+	static const int kRows = kGridHeight/kStep+1;
+
+	std::vector<cv::Point2f> table;//kColumns*kRows nodes, row by row
+};
+
+#endif // SCREEN_MAPPING_H
@@ -0,0 +1,41 @@
+#ifndef SKELETON_FRAME_H
+#define SKELETON_FRAME_H
+
+#include <QtGlobal>
+#include <array>
+
+//Position of a joint in skeleton space (meters), same layout as the Vector4 of the Kinect SDK
+struct JointPosition
+{
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+//Same values as NUI_SKELETON_TRACKING_STATE
+enum SkeletonState
+{
+	SkeletonNotTracked = 0, SkeletonPositionOnly = 1, SkeletonTracked = 2
+};
+
+//Same values as NUI_SKELETON_POSITION_INDEX, only the joints used by the game
+enum JointIndex
+{
+	JointHead = 3, JointHandLeft = 7, JointHandRight = 11
+};
+
+//Copy of one skeleton frame of the sensor, fixed size so it never allocates.
+//The joints stay in skeleton space, only the ones read are transformed
+struct SkeletonFrame
+{
+	static const int kSkeletonCount = 6;
+	static const int kJointCount = 20;
+
+	qint64 timestamp; //(ms) given by the sensor
+	qint64 arrival; //(us) on the clock of QKinect, when the frame was signaled
+	std::array<SkeletonState, kSkeletonCount> states;
+	std::array<std::array<JointPosition, kJointCount>, kSkeletonCount> joints;
+};
+
+#endif // SKELETON_FRAME_H
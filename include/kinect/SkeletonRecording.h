@@ -0,0 +1,97 @@
+#ifndef SKELETON_RECORDING_H
+#define SKELETON_RECORDING_H
+
+#include "SkeletonFrame.h"
+
+#include <QFile>
+#include <QVector>
+#include <QString>
+
+//Recording of what a KinectSensor delivered : the skeleton frames and,
+//optionally, the color frames. SkeletonRecording maps the file in memory,
+//a frame is read in place through the index at the end of the file.
+//
+//Layout : Header | payload of each frame (16 bytes aligned) | index (Entry array)
+namespace SkeletonRecordingFormat
+{
+	enum Kind
+	{
+		SkeletonKind = 1, ColorKind = 2
+	};
+
+	struct Header
+	{
+		char magic[8];
+		quint32 version;
+		quint32 frameSize; //sizeof(SkeletonFrame) of the build that recorded
+		quint32 count;
+		quint32 reserved;
+		qint64 indexOffset;
+	};
+
+	struct Entry
+	{
+		qint64 offset;
+		qint64 arrival; //(us) since the start of the recording
+		quint32 kind;
+		quint32 size;
+	};
+
+	static const quint32 kVersion = 1;
+	static const qint64 kAlignment = 16;
+}
+
+class SkeletonRecorder
+{
+public:
+	SkeletonRecorder();
+	~SkeletonRecorder();
+
+	bool open(const QString& _path);
+	bool isOpen() const {return file.isOpen();}
+	void addSkeletons(const SkeletonFrame& _frame);
+	void addColor(const uchar* _data, unsigned long _size, qint64 _arrival);
+	//Writes the index, the file is unusable until then
+	void close();
+
+private:
+	SkeletonRecorder(const SkeletonRecorder&);	// Don't Implement
+	void operator=(const SkeletonRecorder&);		// Don't implement
+
+	void add(SkeletonRecordingFormat::Kind _kind, const char* _data, quint32 _size, qint64 _arrival);
+
+	QFile file;
+	QVector<SkeletonRecordingFormat::Entry> index;
+	qint64 firstArrival;
+};
+
+class SkeletonRecording
+{
+public:
+	SkeletonRecording();
+	~SkeletonRecording();
+
+	bool open(const QString& _path);
+	bool isOpen() const {return data != 0;}
+	void close();
+
+	int count() const {return nbFrames;}
+	SkeletonRecordingFormat::Kind kind(int _i) const {return static_cast<SkeletonRecordingFormat::Kind>(index[_i].kind);}
+	qint64 arrival(int _i) const {return index[_i].arrival;}
+	quint32 size(int _i) const {return index[_i].size;}
+	const uchar* payload(int _i) const {return data+index[_i].offset;}
+
+	//First frame arrived at or after _arrival, count() if there is none
+	int find(qint64 _arrival) const;
+
+private:
+	SkeletonRecording(const SkeletonRecording&);	// Don't Implement
+	void operator=(const SkeletonRecording&);		// Don't implement
+
+	QFile file;
+	const uchar* data;
+	const SkeletonRecordingFormat::Entry* index;
+	int nbFrames;
+};
+
+#endif // SKELETON_RECORDING_H
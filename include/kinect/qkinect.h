@@ -18,13 +18,16 @@
 #include <QPair>
 #include <QThread>
 #include <QMutex>
-#include <basetyps.h>
-#include <WTypes.h>
-#include <Windows.h>
-#include <NuiApi.h>
+#include <QElapsedTimer>
 #include <array>
 
 #include "RectangleDetection.h"
+#include "ScreenMapping.h"
+#include "KinectSensor.h"
+#include "SkeletonRecording.h"
+#include "HandFilter.h"
+#include "include/utils/TripleBuffer.h"
+#include "include/utils/LatencyStats.h"
 #include "opencv2/core/core.hpp"
 
 #define video_width 1280//640
@@ -32,16 +35,22 @@
 
 class QSize;
 
+//Hands of the two players, filtered on the Kinect thread
+struct HandsFrame
+{
+	HandsFrame() : arrival(0) {}
+
+	QPoint first; //Player on the left half of the screen, null if absent
+	QPoint second; //Player on the right half of the screen, null if absent
+	qint64 arrival; //(us) arrival of the skeleton frame, on the clock of QKinect
+};
+
 class QKinect : public QThread
 {
 	Q_OBJECT
 
-	//skeleton
-	static const int cScreenWidth  = 320;
-    static const int cScreenHeight = 240;
-
 public:
-	QKinect(QSize* screenSize);
+	QKinect(QSize* screenSize, KinectSensor* sensor = nullptr); //Takes the ownership of the sensor, the Kinect of the SDK by default
 	~QKinect();
 	bool isKinectAvailable();
 	inline bool isConnected() const { return m_connected; }
@@ -52,15 +61,20 @@ public:
 	void setElevationAngle(int angle);
 
 	void calibrate();
+	//Records the skeleton frames and the color frames of the calibration, to call before startKinect()
+	bool startRecording(const QString& path);
+	//Parameters of the filter of the hands, to call before startKinect()
+	void setHandFilter(const HandFilter::Parameters& parameters);
 
+	//Shares the buffer of the sensor, valid until the next color frame (copy() it to keep it). Null once calibrated
 	QImage getFrameColorCamera();
 	inline unsigned long getFrameColorSize() const { return m_frameColorSize; }
-	inline BYTE* getFrameColorData() const { return m_frameColorData; }
-	inline QList<QList<QPoint>>* getSkeleton() { return &m_skeletons; }
-	QList<QList<QPoint>> getRealSkeletons();
+	inline const uchar* getFrameColorData() const { return m_frameColorData; }
 	inline int getElevationAngle() const { return m_angle; }
 	QString getStatutsDescription();
 	QPair<QPoint, QPoint>  getHandsPosition();
+	//(us) arrival of each hands frame -> its first read, since the start. GUI thread only
+	inline const LatencyStats& getHandsAge() const { return m_handsAge; }
 	QList<QPoint> getCorners();
 
 protected:
@@ -71,22 +85,23 @@ signals:
 	void newDatas();
 	void calibrated();
 
-private slots:
-	void update();
-
 private:
-	static const int kNbImages = 10;
+	static const int kFrameTimeout = 100; //(ms) the thread checks m_run at least this often
+
 	bool init();
+	void update(int streams);
 	void addImage();
-	bool processSkeleton();
-	bool processColor();
+	bool processSkeleton(qint64 arrival);
+	bool processColor(qint64 arrival);
+	void updateHands(const SkeletonFrame& frame);
+	void releaseColor();
 	void infos(QString);
-	QPoint SkeletonToScreen(Vector4,int,int);
+	QPoint JointToScreen(const JointPosition&,int,int) const;
 
-	INuiSensor* m_kinect; //Kinect device
+	KinectSensor* m_sensor; //Kinect device
+	QElapsedTimer m_clock; //Arrival time of the frames
+	SkeletonRecorder* m_recorder;
 	QSize* m_screenSize; //Size of the widget that use the kinect
-	QPoint m_realScreenPosition;
-	QSize m_realScreenSize;
 	bool m_connected;
 	bool m_run;
 	int m_angle;
@@ -94,20 +109,24 @@ private:
 	bool m_calibrated;
 	bool m_ready;
 	bool m_hasToCalibrate;
-	QMutex mutex;
 
 	std::array<cv::Point,4> m_points;
 
 	//Color camera
-    HANDLE m_pColorStreamHandle;
-    HANDLE m_hNextColorFrameEvent;
 	unsigned long m_frameColorSize; //Size of the image (just for be sure that the image is complete)
-	BYTE* m_frameColorData;
+	const uchar* m_frameColorData;
+	quint64 m_colorBytes; //Received since the start of the stream
+	int m_colorFrames;
 
 	//Skeleton
-    HANDLE m_pSkeletonStreamHandle;
-    HANDLE m_hNextSkeletonEvent;
-	QList<QList<QPoint>> m_skeletons;
+	SkeletonFrame m_skeletonFrame; //Last frame read, only used by the Kinect thread
+	ScreenMapping m_mapping; //Depth image -> green screen, built by the calibration
+	std::array<HandFilter,2> m_handFilters; //One per player
+	qint64 m_lastTimestamp; //(ms) sensor time of the previous skeleton frame
+
+	TripleBuffer<HandsFrame> m_hands; //Written by the Kinect thread, read by the GUI thread
+	LatencyStats m_handsAge; //(us) arrival -> first read of the hands, GUI thread only
+	qint64 m_lastHandsArrival; //Arrival of the last hands frame counted in m_handsAge
 
 	RectangleDetection m_rectangleDetection;
 };
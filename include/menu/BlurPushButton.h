@@ -10,21 +10,19 @@ public:
 	~BlurPushButton();
 	static QImage blurred(const QImage& image, const QRect& rect, int radius, bool alphaOnly);
 	void setHandOnTop(bool isOnTop);
+	//One tick of the dwell clock of the menu, clicks the button once it is full
+	void dwell();
 
 protected:
 	void resizeEvent(QResizeEvent* event);
 	void paintEvent(QPaintEvent* event);
 
 private:
-	static QImage original;
+	static const QImage& original();
 	QPixmap blur;
 	QImage background;
 	bool handOnTop;
 	qreal progress;
-	QTimer timer;
-
-private slots:
-	void clockTick();
 };
 
 #endif // BLURPUSHBUTTON_H
@@ -13,6 +13,7 @@ class GameEngine;
 class QKinect;
 class Overlay;
 class BlurPushButton;
+class ResourcePrewarmer;
 
 class KinectWindow : public QMainWindow
 {
@@ -27,6 +28,8 @@ public slots:
     
 private slots:
 	void handsMoved();
+	void pageChanged();
+	void dwellTick();
 	void back();
     void on_btnGame_clicked();
 	void on_btnOptions_clicked();
@@ -39,8 +42,12 @@ private slots:
 
 protected:
 	void paintEvent(QPaintEvent *event);
+	void resizeEvent(QResizeEvent *event);
 
 private:
+	void indexButtons();
+	BlurPushButton* buttonAt(const QPoint& point) const;
+	void hover(int hand, BlurPushButton* button);
 	void unselectShips();
 	void unselectBonuses();
     Ui::KinectWindow *ui;
@@ -55,11 +62,15 @@ private:
     WiimoteEngine* we;
 	QKinect* kinect;
     GameEngine* ge;
+	ResourcePrewarmer* prewarmer;
 	QMediaPlayer *menuMusic;
 	QPoint hand1;
 	QPoint hand2;
 	QPixmap background;
 	BlurPushButton** hoverButtons;
+	QVector<QPair<QRect, BlurPushButton*> > hitButtons; //Visible buttons of the current page, in window coordinates
+	bool hitButtonsDirty;
+	QTimer dwellClock; //Fills the buttons under the hands
 	QButtonGroup p1ShipsGroup;
 	QButtonGroup p2ShipsGroup;
 	QButtonGroup p1BonusGroup;
@@ -69,6 +80,7 @@ private:
 private slots:
     void validateShips(int);
     void validateBonus(int);
+	void prewarmFinished();
 };
 
 #endif // KINECTWINDOW_H
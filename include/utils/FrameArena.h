@@ -0,0 +1,80 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <QVector>
+#include <cstddef>
+#include <new>
+
+//Bump allocator for the data that only lives during one tick of the game loop.
+//Memory is never given back piece by piece, reset() rewinds the whole arena in O(1)
+//and the blocks are kept for the next tick, so malloc is only hit while warming up.
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t _blockSize);
+    ~FrameArena();
+
+    void* allocate(size_t _size, size_t _align);
+    void reset();
+
+    size_t capacity() const;
+    size_t peakUsage() const {return peak;}
+
+private:
+    FrameArena(const FrameArena&);      // Don't Implement
+    void operator=(const FrameArena&);  // Don't implement
+
+    struct Block
+    {
+        char* data;
+        size_t size;
+    };
+
+    QVector<Block> blocks;
+    size_t blockSize;
+    int current;
+    size_t offset;
+    size_t used;
+    size_t peak;
+};
+
+//STL allocator on top of a FrameArena, deallocate() does nothing
+template<typename T>
+class FrameAllocator
+{
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind {typedef FrameAllocator<U> other;};
+
+    FrameAllocator(FrameArena& _arena):arena(&_arena) {}
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& _other):arena(_other.arena) {}
+
+    pointer address(reference _x) const {return &_x;}
+    const_pointer address(const_reference _x) const {return &_x;}
+
+    pointer allocate(size_type _n, const void* = 0) {return static_cast<pointer>(arena->allocate(_n*sizeof(T), Q_ALIGNOF(T)));}
+    void deallocate(pointer, size_type) {}
+    size_type max_size() const {return static_cast<size_type>(-1)/sizeof(T);}
+
+    void construct(pointer _p, const T& _value) {new(static_cast<void*>(_p)) T(_value);}
+    void destroy(pointer _p) {_p->~T();}
+
+    FrameArena* arena;
+};
+
+template<typename T, typename U>
+bool operator==(const FrameAllocator<T>& _a, const FrameAllocator<U>& _b) {return _a.arena == _b.arena;}
+
+template<typename T, typename U>
+bool operator!=(const FrameAllocator<T>& _a, const FrameAllocator<U>& _b) {return _a.arena != _b.arena;}
+
+#endif // FRAMEARENA_H
@@ -0,0 +1,35 @@
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <QString>
+
+//Count, minimum, maximum and average of all the samples, percentiles of the
+//last kWindow ones. The storage is fixed, addSample() never allocates.
+class LatencyStats
+{
+public:
+    static const int kWindow = 4096;
+
+    LatencyStats();
+
+    void addSample(qint64 _value);
+    void clear();
+
+    int count() const {return nbSamples;}
+    qint64 minimum() const {return nbSamples == 0 ? 0 : minValue;}
+    qint64 maximum() const {return nbSamples == 0 ? 0 : maxValue;}
+    qreal average() const;
+    qint64 percentile(qreal _p) const;
+
+    QString summary(const QString& _unit) const;
+
+private:
+    qint64 window[kWindow];
+    int next; //Slot of the next sample, the oldest one once the window is full
+    int nbSamples;
+    qint64 minValue;
+    qint64 maxValue;
+    qint64 total;
+};
+
+#endif // LATENCYSTATS_H
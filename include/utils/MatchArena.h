@@ -0,0 +1,60 @@
+#ifndef MATCHARENA_H
+#define MATCHARENA_H
+
+#include <QVector>
+#include <cstddef>
+
+//Pool allocator for everything that lives as long as a match (spaceships, asteroids, projectiles, ...).
+//Freed objects go back to a free list of their size class, oversized ones to a list of large blocks.
+//reset() doesn't destroy anything : the objects must have been deleted before (their destructors
+//detach them from the scene and the signals), it only rewinds the chunks for the next match.
+//release() frees the memory. Shared resources (sprites, sounds) must not be allocated here.
+class MatchArena
+{
+public:
+    explicit MatchArena(size_t _chunkSize);
+    ~MatchArena();
+
+    void* allocate(size_t _size);
+    void free(void* _p, size_t _size);
+    void reset();
+    void release();
+
+    int liveObjects() const {return live;}
+    size_t capacity() const {return chunks.size()*chunkSize;}
+
+    //Blocks handed out by these two remember their arena (0 = global heap) in a small header,
+    //so a plain delete finds its way back whatever the allocation was
+    static void* allocateTagged(MatchArena* _arena, size_t _size);
+    static void freeTagged(void* _p);
+
+private:
+    MatchArena(const MatchArena&);      // Don't Implement
+    void operator=(const MatchArena&);  // Don't implement
+
+    static const size_t kGranularity = 16;
+    static const int kNbClasses = 48;   //Objects up to 768 bytes, bigger ones get a block of their own
+    static const size_t kHeaderSize = 16;
+
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    struct LargeBlock
+    {
+        char* data;
+        size_t size;
+    };
+
+    FreeNode* freeLists[kNbClasses];
+    QVector<char*> chunks;
+    QVector<LargeBlock> largeBlocks;
+    QVector<LargeBlock> freeLargeBlocks;
+    size_t chunkSize;
+    int current;
+    size_t offset;
+    int live;
+};
+
+#endif // MATCHARENA_H
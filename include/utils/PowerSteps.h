@@ -0,0 +1,22 @@
+#ifndef POWERSTEPS_H
+#define POWERSTEPS_H
+
+#include <QVector>
+#include <cmath>
+
+//n^power for the tick count n of an item walking its curve. The first
+//MULTI_POWER_TABLE_SIZE values are read from a table shared by every
+//item with the same exponent, pow() only runs beyond it.
+class PowerSteps
+{
+public:
+    explicit PowerSteps(qreal _power);
+
+    qreal at(int _n) const {return _n < table->size() ? table->at(_n) : pow(static_cast<qreal>(_n), power);}
+
+private:
+    qreal power;
+    const QVector<qreal>* table;
+};
+
+#endif // POWERSTEPS_H
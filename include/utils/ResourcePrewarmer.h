@@ -0,0 +1,48 @@
+#ifndef RESOURCEPREWARMER_H
+#define RESOURCEPREWARMER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QImage>
+#include <QMutex>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+//Decodes the game sprites on worker threads while the players are in the menu.
+//QPixmap can only be created on the GUI thread, so the workers produce QImages which
+//are turned into pixmaps and put in the SpriteCache as they arrive.
+class ResourcePrewarmer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ResourcePrewarmer(QObject *parent = 0);
+    ~ResourcePrewarmer();
+
+    void start();
+    bool isStarted() const {return started;}
+    bool isFinished() const {return done;}
+    void waitForFinished();
+
+    static QStringList gameSprites();
+
+signals:
+    void finished();
+
+private slots:
+    void imagesDecoded();
+
+private:
+    class DecodeTask;
+
+    void addDecoded(const QString& path, const QImage& image);
+
+    QThreadPool pool;
+    QMutex mutex;
+    QList<QPair<QString, QImage> > decoded;
+    int pending;
+    bool started;
+    bool done;
+    QElapsedTimer chrono;
+};
+
+#endif // RESOURCEPREWARMER_H
@@ -0,0 +1,59 @@
+#ifndef SPRITEARCHIVE_H
+#define SPRITEARCHIVE_H
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QString>
+
+//Pre-decoded images of the resources, written once by the build (Starfighter4K --pack-sprites <file>)
+//and mapped in memory at startup. The pixels are already premultiplied ARGB32, so an image is
+//only a view on the mapping: nothing is decoded or copied until it is turned into a QPixmap.
+//
+//Layout : Header | pixels of each image (16 bytes aligned) | index (QDataStream)
+class SpriteArchive
+{
+public:
+    SpriteArchive();
+    ~SpriteArchive();
+
+    bool open(const QString& _path);
+    bool isOpen() const {return data != 0;}
+    bool contains(const QString& _name) const {return index.contains(_name);}
+    QImage image(const QString& _name) const;
+
+    static SpriteArchive& global();
+    //From the global archive if it has it, decoded from the resources otherwise
+    static QImage loadImage(const QString& _name);
+
+    static bool pack(const QString& _path);
+
+private:
+    SpriteArchive(const SpriteArchive&);    // Don't Implement
+    void operator=(const SpriteArchive&);   // Don't implement
+
+    struct Header
+    {
+        char magic[8];
+        quint32 version;
+        quint32 count;
+        qint64 indexOffset;
+    };
+
+    struct Entry
+    {
+        qint32 width;
+        qint32 height;
+        qint32 bytesPerLine;
+        qint64 offset;
+    };
+
+    static const quint32 kVersion = 1;
+    static const qint64 kAlignment = 16;
+
+    QFile file;
+    const uchar* data;
+    QHash<QString, Entry> index;
+};
+
+#endif // SPRITEARCHIVE_H
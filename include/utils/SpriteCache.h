@@ -0,0 +1,28 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <QHash>
+#include <QPixmap>
+#include <QString>
+#include <QVector>
+
+//Decoded sprites shared by all the entities of all the matches.
+//The references handed out stay valid until clear() (QHash nodes don't move), so the
+//entities point into the cache instead of owning a copy of their picture.
+class SpriteCache
+{
+public:
+    static const QPixmap& pixmap(const QString& _path);
+    static bool contains(const QString& _path);
+    static void insert(const QString& _path, const QPixmap& _pixmap);
+    //_sprite rotated around its center, the angle is rounded to one of the SPRITE_ROTATION_BINS.
+    //_sprite itself when the angle rounds to 0
+    static const QPixmap& rotated(const QPixmap& _sprite, qreal _degrees);
+    static void clear();
+
+private:
+    static QHash<QString, QPixmap> sprites;
+    static QHash<qint64, QVector<QPixmap> > rotations;//By QPixmap::cacheKey(), shared copies have the same
+};
+
+#endif // SPRITECACHE_H
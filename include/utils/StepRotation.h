@@ -0,0 +1,52 @@
+#ifndef STEPROTATION_H
+#define STEPROTATION_H
+
+#include <QtGlobal>
+#include <cmath>
+
+//Point on the unit circle that walks by a constant angle. Each step is a
+//complex multiply by (cos(step), sin(step)) instead of a cos/sin of the
+//growing argument; the first-order renormalisation keeps the radius at 1 so
+//the rounding drift stays at a few ulps over the lifetime of an item.
+class StepRotation
+{
+public:
+    StepRotation() :c(1.0),s(0.0),stepC(1.0),stepS(0.0) {}
+    StepRotation(qreal _argument, qreal _step) {reset(_argument, _step);}
+
+    void reset(qreal _argument, qreal _step)
+    {
+        setArgument(_argument);
+        stepC = cos(_step);
+        stepS = sin(_step);
+    }
+
+    //Jump to an arbitrary argument, keeping the step
+    void setArgument(qreal _argument)
+    {
+        c = cos(_argument);
+        s = sin(_argument);
+    }
+
+    void next()
+    {
+        qreal l_c = c*stepC-s*stepS;
+        s = s*stepC+c*stepS;
+        c = l_c;
+
+        qreal l_k = (3.0-(c*c+s*s))*0.5;
+        c *= l_k;
+        s *= l_k;
+    }
+
+    qreal cosine() const {return c;}
+    qreal sine() const {return s;}
+
+private:
+    qreal c;
+    qreal s;
+    qreal stepC;
+    qreal stepS;
+};
+
+#endif // STEPROTATION_H
@@ -0,0 +1,44 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <QAtomicInt>
+
+//Three slots shared by one writer thread and one reader thread, neither of
+//them ever waits. The writer fills writeBuffer() then publish() swaps it with
+//the middle slot; read() swaps the middle slot with its own one only when a
+//newer value was published, otherwise it keeps returning the last one.
+//The slots are never copied, they are reused from one frame to the next.
+template<class T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() :middle(1),back(2),front(0) {}
+
+    T& writeBuffer() {return buffers[back];}
+
+    void publish()
+    {
+        back = middle.fetchAndStoreOrdered(back|kFresh) & kIndexMask;
+    }
+
+    const T& read()
+    {
+        if(middle.loadAcquire() & kFresh)
+            front = middle.fetchAndStoreOrdered(front) & kIndexMask;
+        return buffers[front];
+    }
+
+private:
+    TripleBuffer(const TripleBuffer&);      // Don't Implement
+    void operator=(const TripleBuffer&);    // Don't implement
+
+    static const int kIndexMask = 3;
+    static const int kFresh = 4;
+
+    T buffers[3];
+    QAtomicInt middle;//index of the middle slot, kFresh if not read yet
+    int back;//only touched by the writer
+    int front;//only touched by the reader
+};
+
+#endif // TRIPLEBUFFER_H
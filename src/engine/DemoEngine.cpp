@@ -6,11 +6,12 @@
 #include "include/game/Asteroid.h"
 #include "include/game/BlackShip.h"
 #include "include/engine/SpawnEngine.h"
+#include "include/utils/SpriteCache.h"
 
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <include/stable.h>
-DemoEngine::DemoEngine(QWidget* parent):GameEngine(parent),bg(BACKGROUND),angleBg(M_PI/4.0)
+DemoEngine::DemoEngine(QWidget* parent):GameEngine(parent),bg(SpriteCache::pixmap(BACKGROUND)),angleBg(M_PI/4.0)
 {
     scene = new QGraphicsScene(0,0,width(),height(),this);
     setScene(scene);
@@ -28,6 +29,7 @@ DemoEngine::DemoEngine(QWidget* parent):GameEngine(parent),bg(BACKGROUND),angleB
     setFocusPolicy(Qt::NoFocus);
     bgScene = scene->addPixmap(bg);
     bgScene->setPos(-(offset+1),-(offset+1));
+    scene->addItem(projectileStore.createLayer());
 
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
@@ -39,6 +41,7 @@ DemoEngine::DemoEngine(QWidget* parent):GameEngine(parent),bg(BACKGROUND),angleB
 DemoEngine::~DemoEngine()
 {
 	delete bgScene;
+    deleteList(listProjectile);//The stored ones are not in the scene
 	qDeleteAll(scene->items());
 }
 
@@ -66,6 +69,9 @@ void DemoEngine::escapeGame(bool isKey)
 
 void DemoEngine::timerEvent(QTimerEvent *)
 {
+    spawnControl.tickStarted();
+    flushSpawns();
+
     int factorX = (cos(angleBg) >= 0) ? -1 : 1;
     int factorY = (sin(angleBg) >= 0) ? -1 : 1;//Inverse
 
@@ -82,8 +88,9 @@ void DemoEngine::timerEvent(QTimerEvent *)
     bgScene->moveBy(factorX*BACKGROUND_DX,factorY*BACKGROUND_DY);
 
     scene->advance();
+    projectileStore.advance();
 
-    checkOutsideScene(listProjectile);
+    checkOutsideProjectiles();
     checkOutsideScene(listAsteroide);
     checkOutsideScene(listSmallAsteroide);
     checkOutsideScene(listBonus);
@@ -94,6 +101,9 @@ void DemoEngine::timerEvent(QTimerEvent *)
 
     runTestCollision(listAsteroide);
     runTestCollision(listSmallAsteroide);
+
+    processDeaths();
+    spawnControl.tickFinished();
 }
 
 qreal DemoEngine::xminWarzone() const
@@ -115,19 +125,22 @@ void DemoEngine::addAsteroid(Asteroid *_inAsteroid)
 {
     scene->addItem(_inAsteroid);
     listAsteroide.append(_inAsteroid);
-    connect(_inAsteroid,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _inAsteroid->setDeathQueue(&deathQueue);
 }
 
 void DemoEngine::addBlackship(Blackship* _blackship)
 {
     scene->addItem(_blackship);
     listBlackship.append(_blackship);
-    connect(_blackship,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _blackship->setDeathQueue(&deathQueue);
 }
 
 void DemoEngine::addProjectile(Projectile *_inProjectile)
 {
-    scene->addItem(_inProjectile);
+    if(_inProjectile->hasLinearMotion())
+        projectileStore.insert(_inProjectile);
+    else
+        scene->addItem(_inProjectile);
 	listProjectile.append(_inProjectile);
 }
 
@@ -135,7 +148,7 @@ void DemoEngine::addSmallAsteroid(Asteroid *_inAsteroid)
 {
     scene->addItem(_inAsteroid);
     listSmallAsteroide.append(_inAsteroid);
-    connect(_inAsteroid,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _inAsteroid->setDeathQueue(&deathQueue);
 }
 
 void DemoEngine::addBonus(Bonus *_inBonus)
@@ -148,20 +161,25 @@ void DemoEngine::addAlienSpaceship(AlienSpaceship *_inAlienSpaceship)
 {
     scene->addItem(_inAlienSpaceship);
     listAlienSpaceship.append(_inAlienSpaceship);
-    connect(_inAlienSpaceship,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _inAlienSpaceship->setDeathQueue(&deathQueue);
 }
 
 void DemoEngine::elemenDestroyed(Destroyable *_destroyItem, int, Shooter)
 {
-    if(Asteroid* a = dynamic_cast<Asteroid*>(_destroyItem))
+    switch(_destroyItem->getTypeObject())
     {
-        if(a->isSmall())
-            removeSmallAsteroid(a);
-        else
-            removeAsteroid(a);
+        case tAsteroid:
+            removeAsteroid(static_cast<Asteroid*>(_destroyItem));
+            break;
+        case tSmallAsteroid:
+            removeSmallAsteroid(static_cast<Asteroid*>(_destroyItem));
+            break;
+        case tAlien:
+            removeAlienSpaceship(static_cast<AlienSpaceship*>(_destroyItem));
+            break;
+        default:
+            break;
     }
-    else if(AlienSpaceship* a = dynamic_cast<AlienSpaceship*>(_destroyItem))
-        removeAlienSpaceship(a);
 }
 
 void DemoEngine::removeItemScene(Displayable* item)
@@ -2,6 +2,7 @@
 #include "include/engine/UserControlsEngine.h"
 #include "include/engine/GameEngine.h"
 #include "include/engine/SpawnEngine.h"
+#include "include/engine/GameView.h"
 
 #include "include/game/Displayable.h"
 #include "include/game/Spaceship.h"
@@ -11,11 +12,13 @@
 #include "include/utils/Settings.h"
 #include "include/config/Define.h"
 #include "include/menu/HUDWidget.h"
+#include "include/utils/SpriteCache.h"
 #include "include/config/define.h"
 
 DisplayEngine::DisplayEngine(GameEngine *ge, QWidget *parent)
     :QMainWindow(parent),
-      gameEngine(ge), isFullScreen(true),angleBg(M_PI/4.0),bg(BACKGROUND),countDown(NB_COUNTDOWN),tCountDown(new QTimer),message(0)
+      gameEngine(ge), isFullScreen(false),angleBg(M_PI/4.0),bg(SpriteCache::pixmap(BACKGROUND)),countDown(NB_COUNTDOWN),tCountDown(new QTimer(this)),text(0),message(0),hud(0),
+      shownSeconds(-1),shownScore1(-1),shownScore2(-1),profiler(0),isProfilerShown(false),profilerFrames(0)
 {
     // get screen dimension
     QDesktopWidget * desktop = QApplication::desktop();
@@ -26,23 +29,19 @@ DisplayEngine::DisplayEngine(GameEngine *ge, QWidget *parent)
     //QVBoxLayout * mainScreen = new QVBoxLayout(this);
     //QGridLayout * mainScreen = new QGridLayout(this);
 
-    hud = new HUDWidget(gameEngine);
-    hud->setPlayerName(Player1, Settings::getGlobalSettings().playerOneName());
-    hud->setPlayerName(Player2, Settings::getGlobalSettings().playerTwoName());
-
     int sceneWidth = screenSizeWidth;
     int sceneHeigth = screenSizeHeight;
 
     // configuration of QGraphicsScene and QGraphicsview
     scene = new QGraphicsScene(0,0,sceneWidth,sceneHeigth,this);
-    view = new QGraphicsView(scene,this);
+    view = new GameView(scene,this);
 
     view->setFixedSize(sceneWidth,sceneHeigth);
 
     view->setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
     view->setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
     view->setViewport(new QGLWidget(QGLFormat(QGL::DoubleBuffer),this));
-    view->setRenderHints(QPainter::SmoothPixmapTransform|QPainter::Antialiasing|QPainter::TextAntialiasing);
+    //The render hints follow the quality level, see GameView
 
     //Better performance if we don't use random access in the scene.
     //It's the case because we use QList for Item process
@@ -60,9 +59,7 @@ DisplayEngine::DisplayEngine(GameEngine *ge, QWidget *parent)
     this->setFixedSize(screenSizeWidth,screenSizeHeight);
 
     this->setWindowModality(Qt::ApplicationModal);
-    // Param of the screen
-    //showFullScreen();
-    switchFullScreen();
+    //The window is shown by newMatch()
     //setWindowFlags(Qt::Window | Qt::WindowMinimizeButtonHint);
 
     setCentralWidget(view);
@@ -81,20 +78,66 @@ DisplayEngine::DisplayEngine(GameEngine *ge, QWidget *parent)
     bgScene->setPos(-(offset+1),-(offset+1));
 
 	QFontDatabase().addApplicationFont(FONT_PATH);
+
+	connect(tCountDown,SIGNAL(timeout()),this,SLOT(changeCountDown()));
+}
+
+void DisplayEngine::newMatch()
+{
+    hud = new HUDWidget(gameEngine);
+    hud->setPlayerName(Player1, Settings::getGlobalSettings().playerOneName());
+    hud->setPlayerName(Player2, Settings::getGlobalSettings().playerTwoName());
+
 	QGraphicsProxyWidget* widget = scene->addWidget(hud);
 	widget->setZValue(1000);
-	widget->setGeometry(QRectF(0,0,sceneWidth,114));
+	widget->setGeometry(QRectF(0,0,scene->width(),114));
+
+    shownSeconds = shownScore1 = shownScore2 = -1;
+    view->resetStatistics();
+
+    if(isProfilerShown)
+    {
+        isProfilerShown = false;
+        switchProfiler();
+    }
+
+    //switchFullScreen() toggles the mode, so the window comes back the way the player left it
+    isFullScreen = !isFullScreen;
+    switchFullScreen();
+}
+
+void DisplayEngine::endMatch()
+{
+    tCountDown->stop();
+    splash->hide();
+
+    //The game items are already deleted by GameEngine, what is left is the HUD and the texts.
+    //Only the top level items are deleted, their children go with them
+    QList<QGraphicsItem*> items = scene->items();
+    QList<QGraphicsItem*> toDelete;
+    for(auto it = items.begin(); it != items.end(); ++it)
+        if(*it != bgScene && (*it)->parentItem() == 0)
+            toDelete.append(*it);
+    qDeleteAll(toDelete);
+
+    hud = 0;
+    text = 0;
+    message = 0;
+    profiler = 0;
+
+    view->logStatistics();
+    hide();
 }
 
 void DisplayEngine::startCountDown()
 {
+	countDown = NB_COUNTDOWN;
 	text = new QGraphicsTextItem(QString("%1").arg(countDown));
 	text->setFont(QFont("Helvetica Neue", 72, QFont::Light));
 	text->setDefaultTextColor(QColor(Qt::white));
 	text->setPos(scene->width()/2.0-text->document()->documentLayout()->documentSize().width()/2.0,
 		scene->height()/2.0-text->document()->documentLayout()->documentSize().height()/2.0);
 	tCountDown->start(17);
-	connect(tCountDown,SIGNAL(timeout()),this,SLOT(changeCountDown()));
 	scene->addItem(text);
 }
 
@@ -121,7 +164,7 @@ void DisplayEngine::changeCountDown()
 			hud->startTimer();
 			delete text;
 			text = 0;
-			delete tCountDown;
+			tCountDown->stop();
 		}
 	}
 	else
@@ -148,8 +191,7 @@ void DisplayEngine::moveBG()
 
 DisplayEngine::~DisplayEngine()
 {
-    scene->clear();
-	qDeleteAll(scene->items());
+    scene->clear();//Deletes the items, the scene is empty afterwards
     //Must clear the list in GameEngine
 
     delete affiche;
@@ -193,6 +235,11 @@ void DisplayEngine::addItemScene(Displayable* item)
     scene->addItem(item);
 }
 
+void DisplayEngine::addLayerScene(QGraphicsItem* layer)
+{
+    scene->addItem(layer);
+}
+
 void DisplayEngine::removeItemScene(Displayable *item)
 {
     scene->removeItem(item);
@@ -201,6 +248,76 @@ void DisplayEngine::removeItemScene(Displayable *item)
 void DisplayEngine::updateScreen()
 {
     scene->advance();
+
+    if(profiler != 0 && ++profilerFrames >= PROFILER_REFRESH)
+    {
+        profilerFrames = 0;
+        updateProfiler();
+    }
+}
+
+void DisplayEngine::setTargetPeriod(int _ms)
+{
+    view->setTargetPeriod(_ms);
+}
+
+void DisplayEngine::startFirstFrameTimer()
+{
+    view->startFirstFrameTimer();
+}
+
+qint64 DisplayEngine::firstFrameDelay() const
+{
+    return view->firstFrameDelay();
+}
+
+void DisplayEngine::switchProfiler()
+{
+    isProfilerShown = !isProfilerShown;
+
+    if(isProfilerShown)
+    {
+        profiler = new QGraphicsSimpleTextItem();
+        profiler->setBrush(QBrush(Qt::white));
+        profiler->setFont(QFont("Helvetica Neue", 12));
+        profiler->setZValue(10000);
+        profiler->setPos(offset, OFFSET_HUD+offset);
+        scene->addItem(profiler);
+        updateProfiler();
+    }
+    else
+    {
+        delete profiler;
+        profiler = 0;
+    }
+}
+
+void DisplayEngine::switchPinnedQuality()
+{
+    //Automatic, then each level from the best to the cheapest, then automatic again
+    int l_level = view->governor().pinnedLevel()+1;
+    if(l_level >= RENDER_QUALITY_LEVELS)
+        l_level = -1;
+    view->pinLevel(l_level);
+
+    if(isProfilerShown)
+        updateProfiler();
+}
+
+void DisplayEngine::updateProfiler()
+{
+    const RenderGovernor& l_governor = view->governor();
+    QString l_text = QString("frame %1 ms  paint %2 ms\nquality %3 (x%4)")
+            .arg(l_governor.framePeriod(), 0, 'f', 1)
+            .arg(l_governor.frameCost(), 0, 'f', 1)
+            .arg(l_governor.level())
+            .arg(l_governor.scale());
+    if(l_governor.pinnedLevel() >= 0)
+        l_text += " pinned";
+
+    l_text += QString("  spawn load %1").arg(gameEngine->spawnController().loadLevel());
+
+    profiler->setText(l_text);
 }
 
 void DisplayEngine::setProgressHP1(int _value)
@@ -249,12 +366,23 @@ void DisplayEngine::updateGameData()
 
 void DisplayEngine::updateGameDataTimer(int s)
 {
-    affiche->setHMS(0,s/60,s%60);
-
-    hud->setTimer(*affiche);
-    setGameScore1(gameEngine->ship1()->getScore());
-    setGameScore2(gameEngine->ship2()->getScore());
+    if(s != shownSeconds)
+    {
+        shownSeconds = s;
+        affiche->setHMS(0,s/60,s%60);
+        hud->setTimer(*affiche);
+    }
 
+    if(gameEngine->ship1()->getScore() != shownScore1)
+    {
+        shownScore1 = gameEngine->ship1()->getScore();
+        setGameScore1(shownScore1);
+    }
+    if(gameEngine->ship2()->getScore() != shownScore2)
+    {
+        shownScore2 = gameEngine->ship2()->getScore();
+        setGameScore2(shownScore2);
+    }
 }
 
 
@@ -267,6 +395,14 @@ void DisplayEngine::keyPressEvent(QKeyEvent *event)
         this->switchFullScreen();
         break;
 
+        case Qt::Key_F3:
+        this->switchProfiler();
+        break;
+
+        case Qt::Key_F4:
+        this->switchPinnedQuality();
+        break;
+
         case Qt::Key_Escape:
 			if(text == 0)
 				gameEngine->escapeGame(true);
@@ -314,4 +450,4 @@ void DisplayEngine::removeMessage()
 		delete message;
 		message = 0;
 	}
-}
\ No newline at end of file
+}
\ No newline at end of file
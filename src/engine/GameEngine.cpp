@@ -20,33 +20,22 @@
 
 #include "include/engine/WiimoteEngine.h"
 #include "include/kinect/qkinect.h"
+#include "include/utils/SpriteCache.h"
 
-GameEngine::GameEngine(WiimoteEngine* wiimoteEngine, QKinect* kinect, GameMode gameMode, int duration, SpaceshipType player1Ship, SpaceshipType player2Ship, TypeSpecialBonus sbp1, TypeSpecialBonus sbp2, int difficulty, QWidget *parent = 0)
-	:QGraphicsView(parent),we(wiimoteEngine), kinect(kinect),
-      settings(Settings::getGlobalSettings()),gameMode(gameMode),typeShip1(player1Ship),typeShip2(player2Ship),
-      isRunning(false),idTimer(-1),isTimer(false),timeGame(duration),hasSomeoneWon(false),timeAlreadyCounted(0),typeSP1(sbp1), typeSP2(sbp2)
+GameEngine::GameEngine(WiimoteEngine* wiimoteEngine, QKinect* kinect, QWidget *parent)
+	:QGraphicsView(parent),se(0),frameArena(FRAME_ARENA_BLOCK_SIZE),entityArena(MATCH_ARENA_CHUNK_SIZE),uc(0),we(wiimoteEngine), kinect(kinect),
+      settings(Settings::getGlobalSettings()),gameMode(DeathMatch),typeShip1(NoSpaceShip),typeShip2(NoSpaceShip),
+      isRunning(false),idTimer(-1),isTimer(false),timeGame(0),hasSomeoneWon(false),timeAlreadyCounted(0),typeSP1(TypeSpecialBonusNothing), typeSP2(TypeSpecialBonusNothing)
 {
-    if(this->gameMode==Timer)
-        isTimer=true;
-
     soe = new SoundEngine(settings.soundEffectsVolume(), settings.musicVolume(), this);
     de = new DisplayEngine(this,0);
-    uc = new UserControlsEngine(this, we);
-    se = new SpawnEngine(difficulty, this);
     mutex = new QMutex();
 
     qsrand(QTime(0,0,0).secsTo(QTime::currentTime()));
-
-    createSpaceship();  
-
-	de->startCountDown();
-
-	connect(kinect, SIGNAL(newDatas()), this, SLOT(positionProcess()));
-    connect(we,SIGNAL(orientation(int, qreal)), this, SLOT(rotationProcess(int, qreal)));
 }
 
 GameEngine::GameEngine(QWidget *parent)
-    :QGraphicsView(parent),settings(Settings::getGlobalSettings())
+    :QGraphicsView(parent),frameArena(FRAME_ARENA_BLOCK_SIZE),entityArena(MATCH_ARENA_CHUNK_SIZE),settings(Settings::getGlobalSettings())
 {
     se = new SpawnEngine(Asteroids|AlienMothership|Satellites|BlackSquadron,this,true);
     mutex = new QMutex();
@@ -57,6 +46,9 @@ GameEngine::GameEngine(QWidget *parent)
 
 GameEngine::~GameEngine()
 {
+    //The stored projectiles are not in the scene, it wouldn't delete them
+    deleteList(listProjectile);
+
     if(de != 0) delete de;//Delete all the pointers in the different QList, so we must only clear them
     if(uc != 0) delete uc;
     if(se != 0) delete se;
@@ -71,6 +63,9 @@ GameEngine::~GameEngine()
     listAlienSpaceship.clear();
     listSupernova.clear();
 	listBlackship.clear();
+
+    //The items are gone with the scene, what is left (bonus picked up but never used, ...) is freed with the chunks
+    entityArena.release();
 }
 
 qreal GameEngine::xminWarzone() const
@@ -131,8 +126,8 @@ void GameEngine::createSpaceship()
         path = QString(PICTURE_SPACESHIP_3);
         cooldown = COOLDOWN_3;
     }
-    addShip(new Spaceship(0,height/2,Player1,settings.playerOneName(),healthPoint,resistance,cooldown,typeSP1,this));
-    listSpaceship[0]->setPixmap(new QPixmap(path));
+    addShip(new (entityArena) Spaceship(0,height/2,Player1,settings.playerOneName(),healthPoint,resistance,cooldown,typeSP1,this));
+    listSpaceship[0]->setPixmap(&SpriteCache::pixmap(path));
 
     if(typeShip2==SpaceshipType1)
     {
@@ -155,8 +150,89 @@ void GameEngine::createSpaceship()
         path = QString(PICTURE_SPACESHIP_3);
         cooldown = COOLDOWN_3;
     }
-    addShip(new Spaceship(width,height/2,Player2,settings.playerTwoName(),healthPoint,resistance,cooldown,typeSP2,this));
-    listSpaceship[1]->setPixmap(new QPixmap(path));
+    addShip(new (entityArena) Spaceship(width,height/2,Player2,settings.playerTwoName(),healthPoint,resistance,cooldown,typeSP2,this));
+    listSpaceship[1]->setPixmap(&SpriteCache::pixmap(path));
+}
+
+void GameEngine::newMatch(GameMode gameMode, int duration, SpaceshipType player1Ship, SpaceshipType player2Ship, TypeSpecialBonus sbp1, TypeSpecialBonus sbp2, int difficulty)
+{
+    //Measured up to the first paint of the game view, logged by endMatch()
+    de->startFirstFrameTimer();
+
+    this->gameMode = gameMode;
+    isTimer = gameMode==Timer;
+    timeGame = duration;
+    typeShip1 = player1Ship;
+    typeShip2 = player2Ship;
+    typeSP1 = sbp1;
+    typeSP2 = sbp2;
+
+    hasSomeoneWon = false;
+    timeAlreadyCounted = 0;
+    elapsedTimer.invalidate();
+
+    soe->setVolumes(settings.soundEffectsVolume(), settings.musicVolume());
+    soe->resetStatistics();
+    soe->startMusic();
+
+    de->newMatch();//The HUD depends on the game mode, it must exist before the spaceships
+    de->addLayerScene(projectileStore.createLayer());//Deleted with the other items by DisplayEngine::endMatch()
+    moveCost.clear();
+    uc = new UserControlsEngine(this, we);
+    se = new SpawnEngine(difficulty, this);
+
+    createSpaceship();
+
+	de->startCountDown();
+
+	connect(kinect, SIGNAL(newDatas()), this, SLOT(positionProcess()));
+    connect(we,SIGNAL(orientation(int, qreal)), this, SLOT(rotationProcess(int, qreal)));
+}
+
+void GameEngine::endMatch()
+{
+    if(isRunning)
+        timerControle();
+
+    //No more input until the next match, there is no spaceship to move
+    disconnect(kinect, SIGNAL(newDatas()), this, SLOT(positionProcess()));
+    disconnect(we,SIGNAL(orientation(int, qreal)), this, SLOT(rotationProcess(int, qreal)));
+
+    delete uc;
+    uc = 0;
+    delete se;
+    se = 0;
+    //The time until the next match is not a tick
+    spawnControl.pause();
+
+    //The projectiles go before the spaceships, a guided projectile tells its spaceship when it dies
+    qDeleteAll(deathQueue.discarded());
+    qDeleteAll(listSupernova);
+    listSupernova.clear();
+    deleteList(listProjectile);
+    deleteList(listAsteroide);
+    deleteList(listSmallAsteroide);
+    deleteList(listBonus);
+    deleteList(listAlienSpaceship);
+    deleteList(listBlackship);
+    qDeleteAll(listSpaceship);
+    listSpaceship.clear();
+
+    deathQueue.clear();
+    spawnQueue.discardAll();
+
+    de->endMatch();
+    soe->stopMusic();
+    soe->logStatistics();
+    qDebug() << "Time to first frame :" << de->firstFrameDelay() << "ms";
+    qDebug() << "Spawn cost per tick :" << spawnQueue.tickCost().summary("us") << "worst :" << spawnQueue.tickCost().maximum() << "us";
+    qDebug() << "Move cost per tick :" << moveCost.summary("us") << "worst :" << moveCost.maximum() << "us";
+
+    //Every entity is destroyed by now, one destructor each (they detach the items, the sprites stay in the SpriteCache).
+    //The arena only rewinds its chunks and large blocks, the next match reuses them
+    if(entityArena.liveObjects() != 0)
+        qWarning() << "Entities leaked by the match :" << entityArena.liveObjects();
+    entityArena.reset();
 }
 
 void GameEngine::start()
@@ -169,8 +245,17 @@ void GameEngine::start()
 
 void GameEngine::timerEvent(QTimerEvent *)
 {
+    spawnControl.tickStarted();
+    flushSpawns();
+
     de->moveBG();
+
+    QElapsedTimer l_moveTimer;
+    l_moveTimer.start();
     de->updateScreen();
+    projectileStore.advance();
+    moveCost.addSample(l_moveTimer.nsecsElapsed()/1000);
+
     if(isTimer)
     {
         int delta = timeGame*1000-elapsedTime();
@@ -180,7 +265,7 @@ void GameEngine::timerEvent(QTimerEvent *)
             de->updateGameDataTimer(delta/1000);
     }
 
-    checkOutsideScene(listProjectile);
+    checkOutsideProjectiles();
     checkOutsideScene(listAsteroide);
     checkOutsideScene(listSmallAsteroide);
     checkOutsideScene(listBonus);
@@ -193,19 +278,17 @@ void GameEngine::timerEvent(QTimerEvent *)
         checkCollisionSpaceshipAndList(i,listSmallAsteroide);
     }
     de->updateGameData();
-    //Explode all the supernova
-    for(int i = 0;i<listSupernova.size();i++)
-    {
-        delete listSupernova[i];
-        listSupernova[i]=0;
-    }
-    listSupernova.clear();
 
     runTestCollision(listProjectile);
     clearList(listProjectile);
 
     runTestCollision(listAsteroide);
     runTestCollision(listSmallAsteroide);
+
+    processDeaths();
+
+    frameArena.reset();
+    spawnControl.tickFinished();
 }
 
 int GameEngine::elapsedTime()
@@ -272,56 +355,105 @@ void GameEngine::escapeGame(bool isKey)
 
 void GameEngine::elemenDestroyed(Destroyable* _destroyItem, int nbPoint, Shooter forShip)
 {
-    if(Spaceship* s = dynamic_cast<Spaceship*>(_destroyItem))
+    TypeItem l_type = _destroyItem->getTypeObject();
+
+    if(l_type == tSpaceship)
     {
         timerControle();
-        endGameDeathMatch(s);
+        endGameDeathMatch(static_cast<Spaceship*>(_destroyItem));
+        return;
     }
-    else
-    {
-        if(forShip==Player1)
-            ship1()->addPoint(nbPoint);
-        else if(forShip==Player2)
-            ship2()->addPoint(nbPoint);
 
-        if(Asteroid* a = dynamic_cast<Asteroid*>(_destroyItem))
-        {
-            if(a->isSmall())
-                removeSmallAsteroid(a);
-            else
-                removeAsteroid(a);
-        }
-        else if(AlienSpaceship* a = dynamic_cast<AlienSpaceship*>(_destroyItem))
-        {
-            removeAlienSpaceship(a);
+    if(forShip==Player1)
+        ship1()->addPoint(nbPoint);
+    else if(forShip==Player2)
+        ship2()->addPoint(nbPoint);
+
+    switch(l_type)
+    {
+        case tAsteroid:
+            removeAsteroid(static_cast<Asteroid*>(_destroyItem));
+            break;
+        case tSmallAsteroid:
+            removeSmallAsteroid(static_cast<Asteroid*>(_destroyItem));
+            break;
+        case tAlien:
+            removeAlienSpaceship(static_cast<AlienSpaceship*>(_destroyItem));
             if(forShip==Player1)
                 ship1()->addBonus(se->generateBonus());
             else if(forShip==Player2)
                 ship2()->addBonus(se->generateBonus());
-        }
-		else if(Blackship* s = dynamic_cast<Blackship*>(_destroyItem))
-			removeBlackship(s);
+            break;
+        case tBlackShip:
+            removeBlackship(static_cast<Blackship*>(_destroyItem));
+            break;
+        default:
+            break;
+    }
+}
+
+void GameEngine::processDeaths()
+{
+    //Scores, rewards and removal of the dead.
+    //A handler can delete an item that is queued further, its event is then left empty
+    for(int i = 0;i<deathQueue.size();i++)
+    {
+        DeathEvent l_event = deathQueue.at(i);
+        if(l_event.item != 0)
+            elemenDestroyed(l_event.item, l_event.nbPoint, l_event.forShip);
+    }
+
+    //What is born from the collisions of this tick joins the game for the next one
+    for(int i = 0;i<deathQueue.nbSplinters();i++)
+        Asteroid::createSplinters(this, deathQueue.splinterAt(i));
+
+    //Explode all the supernova
+    for(auto it = listSupernova.begin(); it != listSupernova.end(); ++it)
+    {
+        (*it)->explode();
+        delete *it;
     }
+    listSupernova.clear();
+
+    qDeleteAll(deathQueue.discarded());
+    deathQueue.clear();
+
+    clearList(listAsteroide);
+    clearList(listSmallAsteroide);
+    clearList(listAlienSpaceship);
+    clearList(listBlackship);
 }
 
-void GameEngine::detectObjectAfterMiddleZone(const QList<Displayable*>& list, QList<Projectile*>& projList, Shooter playerActivated)
+void GameEngine::detectObjectAfterMiddleZone(const QList<Displayable*>& list, FrameProjectileList& projList, Shooter playerActivated)
 {
+    qreal middle = sceneSize().width()/2.0;
+
     for(auto it = list.begin(); it != list.end(); ++it)
-        if((*it)->pos().x() < de->sceneSize().width()/2.0 && playerActivated == Player1
-                || (*it)->pos().x() > de->sceneSize().width()/2.0 && playerActivated == Player2)
-            projList.append(static_cast<Projectile*>(*it));
+        if((*it)->pos().x() < middle && playerActivated == Player1
+                || (*it)->pos().x() > middle && playerActivated == Player2)
+        {
+            //The stored projectiles are picked from the arrays of the store
+            if((*it)->getTypeObject() == tProj && projectileStore.contains(static_cast<Projectile*>(*it)))
+                continue;
+            projList.push_back(static_cast<Projectile*>(*it));
+        }
 }
 
 void GameEngine::enableAntiGravity(Shooter playerActivated)
 {
-    QList<Projectile*> projectilesToAntigravitate;
+    FrameProjectileList projectilesToAntigravitate((FrameAllocator<Projectile*>(frameArena)));
+    projectilesToAntigravitate.reserve(listProjectile.size()+listAsteroide.size()+listSmallAsteroide.size());
 
+    projectileStore.collectBeyond(sceneSize().width()/2.0, playerActivated, projectilesToAntigravitate);
     detectObjectAfterMiddleZone(listProjectile, projectilesToAntigravitate, playerActivated);
     detectObjectAfterMiddleZone(listAsteroide, projectilesToAntigravitate, playerActivated);
     detectObjectAfterMiddleZone(listSmallAsteroide, projectilesToAntigravitate, playerActivated);
 
     for(auto it = projectilesToAntigravitate.begin(); it != projectilesToAntigravitate.end(); ++it)
+    {
         (*it)->enableAntiGravity(playerActivated);
+        projectileStore.update(*it);
+    }
 }
 
 void GameEngine::freezePlayer(int duration, Shooter playerDest)
@@ -369,6 +501,8 @@ void GameEngine::timerControle(int tps)
     else
     {
         idTimer = startTimer(tps);
+        spawnControl.setTargetPeriod(tps);
+        de->setTargetPeriod(tps);
         elapsedTimer.start();
         emit signalPause(false);
     }
@@ -377,7 +511,11 @@ void GameEngine::timerControle(int tps)
 
 void GameEngine::addProjectile(Projectile * _inProjectile)
 {
-    de->addItemScene(_inProjectile);
+    //A straight-line projectile is moved and drawn by the store, the scene never sees it
+    if(_inProjectile->hasLinearMotion())
+        projectileStore.insert(_inProjectile);
+    else
+        de->addItemScene(_inProjectile);
 	listProjectile.append(_inProjectile);
 }
 
@@ -386,7 +524,7 @@ void GameEngine::addShip(Spaceship *_inSpaceship)
 
     de->addItemScene(_inSpaceship);
     listSpaceship.append(_inSpaceship);
-    connect(_inSpaceship,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _inSpaceship->setDeathQueue(&deathQueue);
 }
 
 void GameEngine::removeShip(Spaceship *_inSpaceship)
@@ -410,28 +548,28 @@ void GameEngine::addAsteroid(Asteroid *_inAsteroid)
 {
     de->addItemScene(_inAsteroid);
     listAsteroide.append(_inAsteroid);
-    connect(_inAsteroid,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _inAsteroid->setDeathQueue(&deathQueue);
 }
 
 void GameEngine::addSmallAsteroid(Asteroid *_inAsteroid)
 {
     de->addItemScene(_inAsteroid);
     listSmallAsteroide.append(_inAsteroid);
-    connect(_inAsteroid,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _inAsteroid->setDeathQueue(&deathQueue);
 }
 
 void GameEngine::addAlienSpaceship(AlienSpaceship *_inAlienSpaceship)
 {
     de->addItemScene(_inAlienSpaceship);
     listAlienSpaceship.append(_inAlienSpaceship);
-    connect(_inAlienSpaceship,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _inAlienSpaceship->setDeathQueue(&deathQueue);
 }
 
 void GameEngine::addBlackship(Blackship *_blackship)
 {
     de->addItemScene(_blackship);
     listBlackship.append(_blackship);
-    connect(_blackship,SIGNAL(destroyed(Destroyable*,int,Shooter)),this,SLOT(elemenDestroyed(Destroyable*,int,Shooter)));
+    _blackship->setDeathQueue(&deathQueue);
 }
 
 void GameEngine::removeBlackship(Blackship *_blackship)
@@ -486,35 +624,74 @@ void GameEngine::clearList(QList<Displayable*> &list)
           list.removeAt(i--);
 }
 
+void GameEngine::deleteList(QList<Displayable*> &list)
+{
+    qDeleteAll(list);
+    list.clear();
+}
+
 void GameEngine::checkOutsideScene(QList<Displayable*> &list)
 {
     if(list.empty())
         return;
 
+    QRect scene = sceneSize();
+
     for(int i = 0;i<list.size();i++)
         if(list[i] != 0)
         {
-            int l_w = 0;
-            int l_h = 0;
-
             QMutexLocker l(mutex);
-            if(list[i]->isPixmap())
+            if(isOutsideScene(list[i], scene))
             {
-                l_w = list[i]->sizePixmap().width();
-                l_h = list[i]->sizePixmap().height();
+                delete list[i];
+                list[i] = 0;
             }
-
-            if(list[i]->pos().x()-l_w > sceneSize().width() || list[i]->pos().x()+l_w < 0
-            || list[i]->pos().y() > sceneSize().height() || list[i]->pos().y()+offset+l_h < 0)
-                {
-                    delete list[i];
-                    list[i] = 0;
-                }
         }
 
     clearList(list);
 }
 
+void GameEngine::checkOutsideProjectiles()
+{
+    if(listProjectile.empty())
+        return;
+
+    QRect scene = sceneSize();
+
+    //The stored projectiles are all tested at once, the others one by one
+    projectileStore.cull(scene.width(), scene.height(), offset);
+
+    for(int i = 0;i<listProjectile.size();i++)
+        if(listProjectile[i] != 0)
+        {
+            Projectile* l_projectile = static_cast<Projectile*>(listProjectile[i]);
+
+            QMutexLocker l(mutex);
+            if(projectileStore.contains(l_projectile) ? projectileStore.isCulled(l_projectile) : isOutsideScene(l_projectile, scene))
+            {
+                delete listProjectile[i];
+                listProjectile[i] = 0;
+            }
+        }
+
+    clearList(listProjectile);
+}
+
+bool GameEngine::isOutsideScene(const Displayable* item, const QRect& scene) const
+{
+    int l_w = 0;
+    int l_h = 0;
+
+    if(item->isPixmap())
+    {
+        l_w = item->sizePixmap().width();
+        l_h = item->sizePixmap().height();
+    }
+
+    return item->pos().x()-l_w > scene.width() || item->pos().x()+l_w < 0
+            || item->pos().y() > scene.height() || item->pos().y()+offset+l_h < 0;
+}
+
 void GameEngine::removeItemScene(Displayable* item)
 {
     de->removeItemScene(item);
@@ -527,7 +704,7 @@ bool GameEngine::checkCollisionItemAndList(const int i_list1,QList<Displayable*>
 
     QMutexLocker l(mutex);
     if(list2[0]->getTypeObject() == tAlien && list1[i_list1]->getTypeObject() == tProj)
-        if(dynamic_cast<Projectile*>(list1[i_list1])->getFrom()==Alien)
+        if(static_cast<Projectile*>(list1[i_list1])->getFrom()==Alien)
             return false;
 
 	if((list2[0]->getTypeObject() == tAlien || list2[0]->getTypeObject() == tBlackShip) && (list1[i_list1]->getTypeObject() == tAsteroid || list1[i_list1]->getTypeObject() == tSmallAsteroid))
@@ -539,25 +716,30 @@ bool GameEngine::checkCollisionItemAndList(const int i_list1,QList<Displayable*>
             continue;
         if(list1[i_list1] != list2[j] && list1[i_list1]->collidesWithItem(list2[j],Qt::IntersectsItemShape))
         {
+            //What has died during this tick is already gone for the game, it only waits for processDeaths()
+            if(list2[j]->isDying())
+                continue;
+            if(list1[i_list1]->isDying())
+                return false;
+
             if(list1[i_list1]->getTypeObject() == tProj)
             {
-                if(Destroyable* d = dynamic_cast<Destroyable*>(list2[j]))
+                if(Destroyable* d = list2[j]->destroyable())
                 {
                     if(d->gonnaDead(list1[i_list1]->getPower()))
                         if(list2[j]->getTypeObject()==tAsteroid)
-                            dynamic_cast<Asteroid*>(list2[j])->collision(list1[i_list1]->getAngle());
+                            static_cast<Asteroid*>(list2[j])->collision(list1[i_list1]->getAngle());
 
-                    d->receiveAttack(list1[i_list1]->getPower(),list2[j]->getNbPoint(),dynamic_cast<Projectile*>(list1[i_list1])->getFrom());
+                    d->receiveAttack(list1[i_list1]->getPower(),list2[j]->getNbPoint(),static_cast<Projectile*>(list1[i_list1])->getFrom());
 
-                    delete list1[i_list1];
-                    list1[i_list1] = 0;
+                    discard(list1[i_list1]);
 
                     return false;
                 }
                 else if(list2[j]->getTypeObject() == tBonus)
                 {
-                    Projectile* p = dynamic_cast<Projectile*>(list1[i_list1]);
-                    Bonus* b = dynamic_cast<Bonus*>(list2[j]);
+                    Projectile* p = static_cast<Projectile*>(list1[i_list1]);
+                    Bonus* b = static_cast<Bonus*>(list2[j]);
 
                     if(gameMode==Timer)
                     {
@@ -576,40 +758,35 @@ bool GameEngine::checkCollisionItemAndList(const int i_list1,QList<Displayable*>
                     else if(p->getFrom() == Player2)
                         ship2()->addBonus(b);
 
-                    delete list1[i_list1];
-                    list1[i_list1]=0;
+                    discard(list1[i_list1]);
 
                     return true;
                 }
             }
             else if(list1[i_list1]->getTypeObject() == tSmallAsteroid && list2[j]->getTypeObject() == tSmallAsteroid)
             {
-                if(dynamic_cast<Asteroid*>(list1[i_list1])->getIdParent() == dynamic_cast<Asteroid*>(list2[j])->getIdParent() && dynamic_cast<Asteroid*>(list2[j])->getIdParent() != 0)
+                if(static_cast<Asteroid*>(list1[i_list1])->getIdParent() == static_cast<Asteroid*>(list2[j])->getIdParent() && static_cast<Asteroid*>(list2[j])->getIdParent() != 0)
                     return false;
                 else
                 {
-                    delete list1[i_list1];
-                    list1[i_list1] = 0;
+                    discard(list1[i_list1]);
 
-                    delete list2[j];
-                    list2[j] = 0;
+                    discard(list2[j]);
 
                     return true;
                 }
             }
             else if(list1[i_list1]->getTypeObject() == tAsteroid && list2[j]->getTypeObject() == tAsteroid)
             {
-                dynamic_cast<Asteroid*>(list1[i_list1])->collision(list2[j]->getAngle());
-                dynamic_cast<Asteroid*>(list2[j])->collision(list1[i_list1]->getAngle());
+                static_cast<Asteroid*>(list1[i_list1])->collision(list2[j]->getAngle());
+                static_cast<Asteroid*>(list2[j])->collision(list1[i_list1]->getAngle());
             }
             else if(list1[i_list1]->getTypeObject() == tAsteroid && list2[j]->getTypeObject() == tSpaceship)
-                dynamic_cast<Asteroid*>(list1[i_list1])->collision(list2[j]->getAngle());
+                static_cast<Asteroid*>(list1[i_list1])->collision(list2[j]->getAngle());
 
-            delete list1[i_list1];
-            list1[i_list1] = 0;
+            discard(list1[i_list1]);
 
-            delete list2[j];
-            list2[j] = 0;
+            discard(list2[j]);
 
             return true;
         }
@@ -629,21 +806,20 @@ bool GameEngine::checkCollisionSpaceshipAndList(const int i,QList<Displayable*>
         if(list[j]==0)
             return false;
 
-        if(listSpaceship[i]->collidesWithItem(list[j],Qt::IntersectsItemShape))
+        if(listSpaceship[i]->collidesWithItem(list[j],Qt::IntersectsItemShape) && !list[j]->isDying())
         {
             if(gameMode==DeathMatch)
                 listSpaceship[i]->receiveAttack(list[j]->getPower());
             else if(gameMode==Timer && list[j]->getTypeObject() ==tProj)
-                if(dynamic_cast<Projectile*>(list[j])->getFrom()==Player1)
+                if(static_cast<Projectile*>(list[j])->getFrom()==Player1)
                     ship1()->addPoint(list[j]->getNbPoint());
-                else if(dynamic_cast<Projectile*>(list[j])->getFrom()==Player2)
+                else if(static_cast<Projectile*>(list[j])->getFrom()==Player2)
                     ship2()->addPoint(list[j]->getNbPoint());
 
             if(list[j]->getTypeObject()==tAsteroid)
-                dynamic_cast<Asteroid*>(list[j])->collision((listSpaceship[i]->getAngle()));
+                static_cast<Asteroid*>(list[j])->collision((listSpaceship[i]->getAngle()));
 
-            delete list[j];
-            list[j] = 0;
+            discard(list[j]);
             clearList(list);
 
             return true;
@@ -652,6 +828,77 @@ bool GameEngine::checkCollisionSpaceshipAndList(const int i,QList<Displayable*>
     return false;
 }
 
+int GameEngine::nbAlive(Difficulty _category) const
+{
+    switch(_category)
+    {
+        case Asteroids:
+            return listAsteroide.size()+listSmallAsteroide.size();
+        case AlienMothership:
+            return listAlienSpaceship.size();
+        case Satellites:
+            return listBonus.size();
+        case Supernovae:
+            return listSupernova.size();
+        case BlackSquadron:
+            return listBlackship.size();
+        default:
+            return 0;
+    }
+}
+
+void GameEngine::spawnLater(Displayable* _item, SpawnQueue::Target _target)
+{
+    spawnQueue.push(_item, _target);
+}
+
+void GameEngine::spawnLater(const SpawnQueue::Factory& _create, SpawnQueue::Target _target)
+{
+    spawnQueue.push(_create, _target);
+}
+
+void GameEngine::flushSpawns()
+{
+    QElapsedTimer l_timer;
+    l_timer.start();
+
+    //At least one item per tick, a burst always ends
+    int l_nbSpawned = 0;
+    while(!spawnQueue.isEmpty()
+          && (l_nbSpawned == 0 || (l_nbSpawned < SPAWN_BUDGET_COUNT && l_timer.nsecsElapsed() < SPAWN_BUDGET_US*1000LL)))
+    {
+        SpawnQueue::Pending l_pending = spawnQueue.takeFirst();
+        if(l_pending.item == 0)
+            l_pending.item = l_pending.create();
+
+        //Catch up with the items of the same burst that are already flying
+        for(int i = spawnQueue.ticksWaited(l_pending);i>0;i--)
+            l_pending.item->advance(1);
+
+        switch(l_pending.target)
+        {
+            case SpawnQueue::ToAsteroids:
+                addAsteroid(static_cast<Asteroid*>(l_pending.item));
+                break;
+            case SpawnQueue::ToProjectiles:
+                addProjectile(static_cast<Projectile*>(l_pending.item));
+                break;
+            case SpawnQueue::ToBlackships:
+                addBlackship(static_cast<Blackship*>(l_pending.item));
+                break;
+        }
+        l_nbSpawned++;
+    }
+
+    spawnQueue.endTick(l_nbSpawned, l_timer.nsecsElapsed()/1000);
+}
+
+void GameEngine::discard(Displayable*& item)
+{
+    deathQueue.discard(item);
+    item = 0;
+}
+
 void GameEngine::runTestCollision(QList<Displayable*> &list)
 {
     if(list.empty())
@@ -674,4 +921,4 @@ void GameEngine::runTestCollision(QList<Displayable*> &list)
 void GameEngine::quitGame()
 {
 	emit endGame();
-}
\ No newline at end of file
+}
\ No newline at end of file
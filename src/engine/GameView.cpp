@@ -0,0 +1,127 @@
+#include "include/engine/GameView.h"
+
+#include <QGLFramebufferObject>
+
+GameView::GameView(QGraphicsScene* _scene, QWidget* _parent)
+    :QGraphicsView(_scene, _parent),appliedLevel(-1),buffer(0),firstFrame(-1)
+{
+    applyLevel();
+}
+
+GameView::~GameView()
+{
+    releaseBuffer();
+}
+
+void GameView::pinLevel(int _level)
+{
+    renderGovernor.pinLevel(_level);
+    applyLevel();
+}
+
+void GameView::startFirstFrameTimer()
+{
+    firstFrame = -1;
+    firstFrameTimer.start();
+}
+
+void GameView::paintEvent(QPaintEvent* _event)
+{
+    renderGovernor.frameStarted();
+
+    int l_level = renderGovernor.level();
+    if(renderGovernor.scale() < 1.0 && canScale())
+        paintScaled();
+    else
+        QGraphicsView::paintEvent(_event);
+
+    renderGovernor.frameFinished();
+
+    if(renderGovernor.lastPeriod() != 0)
+        levelPeriod[l_level].addSample(renderGovernor.lastPeriod());
+    levelCost[l_level].addSample(renderGovernor.lastCost());
+
+    if(firstFrame < 0 && firstFrameTimer.isValid())
+        firstFrame = firstFrameTimer.elapsed();
+
+    if(renderGovernor.level() != appliedLevel)
+        applyLevel();
+}
+
+bool GameView::canScale()
+{
+    QGLWidget* l_gl = qobject_cast<QGLWidget*>(viewport());
+    if(l_gl == 0)
+        return false;
+
+    l_gl->makeCurrent();
+    return QGLFramebufferObject::hasOpenGLFramebufferObjects();
+}
+
+void GameView::paintScaled()
+{
+    QRect l_target = viewport()->rect();
+    QSize l_size(qMax(1, qRound(l_target.width()*renderGovernor.scale())),
+                 qMax(1, qRound(l_target.height()*renderGovernor.scale())));
+
+    //The framebuffer is kept from one frame to the next, only a new scale reallocates it.
+    //The stencil is there for the clipping of the GL paint engine
+    if(buffer == 0 || buffer->size() != l_size)
+    {
+        delete buffer;
+        buffer = new QGLFramebufferObject(l_size, QGLFramebufferObject::CombinedDepthStencil);
+    }
+
+    {
+        QPainter l_bufferPainter(buffer);
+        l_bufferPainter.setRenderHints(renderHints());
+        l_bufferPainter.fillRect(QRect(QPoint(0, 0), l_size), Qt::black);
+        scene()->render(&l_bufferPainter, QRectF(QPoint(0, 0), l_size), mapToScene(l_target).boundingRect(), Qt::IgnoreAspectRatio);
+    }
+
+    //Drawn through the active paint engine, the texture never leaves the GPU
+    QPainter l_painter(viewport());
+    l_painter.setRenderHints(renderHints());
+    static_cast<QGLWidget*>(viewport())->drawTexture(QRectF(l_target), buffer->texture());
+
+    QRect l_hud(0, 0, l_target.width(), OFFSET_HUD);
+    scene()->render(&l_painter, QRectF(l_hud), mapToScene(l_hud).boundingRect(), Qt::IgnoreAspectRatio);
+}
+
+void GameView::applyLevel()
+{
+    appliedLevel = renderGovernor.level();
+    setRenderHints(renderGovernor.renderHints());
+    if(renderGovernor.scale() >= 1.0)
+        releaseBuffer();
+
+    viewport()->update();
+}
+
+void GameView::releaseBuffer()
+{
+    if(buffer == 0)
+        return;
+
+    //The framebuffer belongs to the context of the viewport
+    if(QGLWidget* l_gl = qobject_cast<QGLWidget*>(viewport()))
+        l_gl->makeCurrent();
+    delete buffer;
+    buffer = 0;
+}
+
+void GameView::logStatistics() const
+{
+    for(int i = 0;i<RENDER_QUALITY_LEVELS;i++)
+        if(levelCost[i].count() != 0)
+            qDebug() << "Render quality level" << i << ": frame" << levelPeriod[i].summary("us") << "paint" << levelCost[i].summary("us");
+}
+
+void GameView::resetStatistics()
+{
+    for(int i = 0;i<RENDER_QUALITY_LEVELS;i++)
+    {
+        levelPeriod[i].clear();
+        levelCost[i].clear();
+    }
+}
@@ -0,0 +1,95 @@
+#include "include/engine/NullAudioSink.h"
+
+#include <QIODevice>
+
+NullAudioSink::NullAudioSink(const QAudioFormat& _format, int _periodMs, QObject* _parent)
+    :QObject(_parent),format(_format),period(_periodMs),source(0),
+      scratch(_format.bytesForDuration(_periodMs*1000), 0),
+      processedBytes(0),notifyInterval(1000),notified(0),
+      currentState(QAudio::StoppedState),currentError(QAudio::NoError)
+{
+    timer.setInterval(_periodMs);
+    connect(&timer, SIGNAL(timeout()), this, SLOT(pull()));
+}
+
+void NullAudioSink::start(QIODevice* _source)
+{
+    source = _source;
+    processedBytes = 0;
+    notified = 0;
+
+    clock.start();
+    timer.start();
+    setState(QAudio::ActiveState, QAudio::NoError);
+}
+
+void NullAudioSink::stop()
+{
+    if(currentState == QAudio::StoppedState)
+        return;
+
+    timer.stop();
+    source = 0;
+    setState(QAudio::StoppedState, QAudio::NoError);
+}
+
+qint64 NullAudioSink::processedUSecs() const
+{
+    return format.durationForBytes(processedBytes);
+}
+
+qint64 NullAudioSink::elapsedUSecs() const
+{
+    return clock.isValid() ? clock.nsecsElapsed()/1000 : 0;
+}
+
+void NullAudioSink::pull()
+{
+    qint64 due = format.bytesForDuration(elapsedUSecs() - period*1000) - processedBytes;
+    if(due <= 0)
+        return;
+
+    qint64 read = 0;
+    while(read < due)
+    {
+        qint64 chunk = source->read(scratch.data(), qMin(due-read, static_cast<qint64>(scratch.size())));
+        if(chunk <= 0)
+            break;
+        read += chunk;
+    }
+    processedBytes += read;
+
+    if(read < due)
+    {
+        if(source->atEnd())
+        {
+            //Played to the end, like QAudioOutput in pull mode
+            timer.stop();
+            setState(QAudio::IdleState, QAudio::NoError);
+        }
+        else
+            setState(QAudio::IdleState, QAudio::UnderrunError);
+    }
+    else if(currentState != QAudio::ActiveState)
+        setState(QAudio::ActiveState, QAudio::NoError);
+
+    if(notifyInterval > 0)
+    {
+        qint64 intervals = processedUSecs() / (notifyInterval*1000);
+        if(intervals > notified)
+        {
+            notified = intervals;
+            emit notify();
+        }
+    }
+}
+
+void NullAudioSink::setState(QAudio::State _state, QAudio::Error _error)
+{
+    currentError = _error;
+    if(currentState == _state)
+        return;
+
+    currentState = _state;
+    emit stateChanged(_state);
+}
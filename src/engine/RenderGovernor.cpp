@@ -0,0 +1,103 @@
+#include "include/engine/RenderGovernor.h"
+#include "include/config/Define.h"
+
+namespace
+{
+const qreal kSmoothing = 0.1;
+
+struct QualityLevel
+{
+    qreal scale;
+    QPainter::RenderHints hints;
+};
+
+//Antialiasing only matters for the few vector shapes, it goes first.
+//The text stays antialiased, the HUD is unreadable otherwise
+const QualityLevel kLevels[RENDER_QUALITY_LEVELS] =
+{
+    {1.0,   QPainter::SmoothPixmapTransform|QPainter::Antialiasing|QPainter::TextAntialiasing},
+    {1.0,   QPainter::SmoothPixmapTransform|QPainter::TextAntialiasing},
+    {1.0,   QPainter::TextAntialiasing},
+    {0.75,  QPainter::TextAntialiasing},
+    {0.5,   QPainter::TextAntialiasing}
+};
+}
+
+RenderGovernor::RenderGovernor()
+    :targetPeriod(REFRESH*1000.0),averagePeriod(0),averageCost(0),nbFrames(0),nbCalm(0),currentLevel(0),
+     pinned(-1),lastPeriodValue(0),lastCostValue(0)
+{
+}
+
+void RenderGovernor::pinLevel(int _level)
+{
+    pinned = _level;
+    if(pinned >= 0)
+        currentLevel = pinned;
+    nbCalm = 0;
+}
+
+void RenderGovernor::frameStarted()
+{
+    lastPeriodValue = 0;
+    if(periodClock.isValid())
+    {
+        qreal l_period = periodClock.nsecsElapsed()/1000.0;
+
+        //Nothing is painted during a pause or a menu, such a gap is not a frame
+        if(l_period < targetPeriod*RENDER_IDLE_RATIO)
+        {
+            lastPeriodValue = qRound64(l_period);
+            averagePeriod = averagePeriod == 0 ? l_period : averagePeriod+kSmoothing*(l_period-averagePeriod);
+        }
+    }
+    periodClock.start();
+    costClock.start();
+}
+
+void RenderGovernor::frameFinished()
+{
+    qreal l_cost = costClock.nsecsElapsed()/1000.0;
+    lastCostValue = qRound64(l_cost);
+    averageCost = averageCost == 0 ? l_cost : averageCost+kSmoothing*(l_cost-averageCost);
+
+    if(++nbFrames >= RENDER_CONTROL_FRAMES)
+    {
+        nbFrames = 0;
+        evaluate();
+    }
+}
+
+void RenderGovernor::evaluate()
+{
+    if(pinned >= 0)
+        return;
+
+    bool l_overloaded = averagePeriod > targetPeriod*RENDER_OVERLOAD_RATIO || averageCost > targetPeriod*RENDER_OVERLOAD_COST;
+    bool l_calm = averagePeriod < targetPeriod*RENDER_RECOVER_RATIO && averageCost < targetPeriod*RENDER_OVERLOAD_COST/2.0;
+
+    nbCalm = l_calm ? nbCalm+1 : 0;
+
+    int l_level = currentLevel;
+    if(l_overloaded && currentLevel < RENDER_QUALITY_LEVELS-1)
+        currentLevel++;
+    else if(nbCalm >= RENDER_RECOVER_EVALS && currentLevel > 0)
+    {
+        currentLevel--;
+        nbCalm = 0;
+    }
+
+    if(l_level != currentLevel)
+        qDebug() << "Render governor : quality level" << l_level << "->" << currentLevel
+                 << "frame" << framePeriod() << "ms paint" << frameCost() << "ms";
+}
+
+qreal RenderGovernor::scale() const
+{
+    return kLevels[currentLevel].scale;
+}
+
+QPainter::RenderHints RenderGovernor::renderHints() const
+{
+    return kLevels[currentLevel].hints;
+}
@@ -1,34 +1,38 @@
 #include "include/engine/SoundEngine.h"
+#include "include/engine/NullAudioSink.h"
 #include "include/config/Define.h"
 
-SoundEngine::SoundEngine(int soundEffectsVolume, int musicVolume, QObject *parent) :
-    QObject(parent)
+//CD quality, what the voices of a real device are mixed to
+static QAudioFormat nullSinkFormat()
 {
-    QString sndDir(SOUNDS_DIR);
-
-    shootMediaPlayer = new QMediaPlayer(this, QMediaPlayer::LowLatency);
-    shootMediaPlayer->setVolume(soundEffectsVolume);
-    shootMediaPlayer->setMedia(QMediaContent(QUrl::fromLocalFile(sndDir + SHOOT_SOUND)));
-
-    satMediaPlayer = new QMediaPlayer(this, QMediaPlayer::LowLatency);
-    satMediaPlayer->setVolume(soundEffectsVolume);
-    satMediaPlayer->setMedia(QMediaContent(QUrl::fromLocalFile(sndDir + SAT_SOUND)));
+    QAudioFormat format;
+    format.setSampleRate(44100);
+    format.setChannelCount(2);
+    format.setSampleSize(16);
+    format.setCodec("audio/pcm");
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setSampleType(QAudioFormat::SignedInt);
+    return format;
+}
 
-    snovaMediaPlayer = new QMediaPlayer(this, QMediaPlayer::LowLatency);
-    snovaMediaPlayer->setVolume(soundEffectsVolume);
-    snovaMediaPlayer->setMedia(QMediaContent(QUrl::fromLocalFile(sndDir + SUPERNOVA_SOUND)));
+SoundEngine::SoundEngine(int soundEffectsVolume, int musicVolume, QObject *parent, bool forceNullSink) :
+    QObject(parent), underruns(0)
+{
+    QString sndDir(SOUNDS_DIR);
 
-	antigravityMediaPlayer = new QMediaPlayer(this, QMediaPlayer::LowLatency);
-	antigravityMediaPlayer->setVolume(soundEffectsVolume);
-	antigravityMediaPlayer->setMedia(QMediaContent(QUrl::fromLocalFile(sndDir + ANTIGRAVITY_SOUND)));
-	
-	freezeMediaPlayer = new QMediaPlayer(this, QMediaPlayer::LowLatency);
-	freezeMediaPlayer->setVolume(soundEffectsVolume);
-	freezeMediaPlayer->setMedia(QMediaContent(QUrl::fromLocalFile(sndDir + FREEZE_SOUND)));
+    //Without output device (headless box, CI), the voices play silence in null sinks: the trigger,
+    //notify and position path is the same, the sink consumes the samples at the rate of a device
+    nullSink = forceNullSink || QAudioDeviceInfo::availableDevices(QAudio::AudioOutput).isEmpty();
+    if(nullSink)
+        nullSamples = QByteArray(nullSinkFormat().bytesForDuration(SOUND_NULL_VOICE_LENGTH*1000), 0);
+    clock.start();
 
-	trackingMediaPlayer = new QMediaPlayer(this, QMediaPlayer::LowLatency);
-	trackingMediaPlayer->setVolume(soundEffectsVolume);
-	trackingMediaPlayer->setMedia(QMediaContent(QUrl::fromLocalFile(sndDir + TRACKING_SOUND)));
+    shootMediaPlayer = createVoice(sndDir + SHOOT_SOUND, soundEffectsVolume);
+    satMediaPlayer = createVoice(sndDir + SAT_SOUND, soundEffectsVolume);
+    snovaMediaPlayer = createVoice(sndDir + SUPERNOVA_SOUND, soundEffectsVolume);
+	antigravityMediaPlayer = createVoice(sndDir + ANTIGRAVITY_SOUND, soundEffectsVolume);
+	freezeMediaPlayer = createVoice(sndDir + FREEZE_SOUND, soundEffectsVolume);
+	trackingMediaPlayer = createVoice(sndDir + TRACKING_SOUND, soundEffectsVolume);
 
     musicMediaPlayer = new QMediaPlayer(this, QMediaPlayer::StreamPlayback);
     musicMediaPlayer->setVolume(musicVolume);
@@ -36,55 +40,173 @@ SoundEngine::SoundEngine(int soundEffectsVolume, int musicVolume, QObject *paren
     pl->addMedia(QMediaContent(QUrl::fromLocalFile(sndDir + GAME_MUSIC)));
     pl->setPlaybackMode(QMediaPlaylist::Loop);
     musicMediaPlayer->setPlaylist(pl);
-    musicMediaPlayer->play();
+}
+
+SoundEngine::~SoundEngine()
+{
+    logStatistics();
+}
+
+QMediaPlayer* SoundEngine::createVoice(const QString& file, int volume)
+{
+    QMediaPlayer* player = new QMediaPlayer(this, QMediaPlayer::LowLatency);
+    player->setVolume(volume);
+    player->setNotifyInterval(SOUND_NOTIFY_INTERVAL);
+    player->setMedia(QMediaContent(QUrl::fromLocalFile(file)));
+
+    connect(player, SIGNAL(positionChanged(qint64)), this, SLOT(voicePositionChanged(qint64)));
+    connect(player, SIGNAL(mediaStatusChanged(QMediaPlayer::MediaStatus)), this, SLOT(voiceStatusChanged(QMediaPlayer::MediaStatus)));
+
+    if(nullSink)
+    {
+        NullVoice voice;
+        voice.sink = new NullAudioSink(nullSinkFormat(), SOUND_NULL_PERIOD, this);
+        voice.sink->setNotifyInterval(SOUND_NOTIFY_INTERVAL);
+        voice.source = new QBuffer(&nullSamples, voice.sink);
+        voice.source->open(QIODevice::ReadOnly);
+        connect(voice.sink, SIGNAL(notify()), this, SLOT(nullVoiceNotify()));
+        connect(voice.sink, SIGNAL(stateChanged(QAudio::State)), this, SLOT(nullVoiceStateChanged(QAudio::State)));
+        nullVoices.insert(player, voice);
+    }
+
+    return player;
+}
+
+QMediaPlayer* SoundEngine::voice(Sounds sound) const
+{
+    switch(sound)
+    {
+    case SatelliteSound:
+        return satMediaPlayer;
+    case ShootSound:
+        return shootMediaPlayer;
+    case SupernovaSound:
+        return snovaMediaPlayer;
+    case TrackingSound:
+        return trackingMediaPlayer;
+    case AntiGravitySound:
+        return antigravityMediaPlayer;
+    case FreezeSound:
+        return freezeMediaPlayer;
+    }
+    return 0;
 }
 
 void SoundEngine::playSound(Sounds toPlay)
 {
-    if(toPlay == SatelliteSound)
+    QMediaPlayer* player = voice(toPlay);
+    if(player != 0)
+        trigger(player);
+}
+
+void SoundEngine::stopSound(Sounds toPlay)
+{
+    QMediaPlayer* player = voice(toPlay);
+    if(player == 0)
+        return;
+
+    if(nullSink)
+    {
+        NullAudioSink* sink = nullVoices.value(player).sink;
+        pendingTriggers.remove(sink);
+        sink->stop();
+    }
+    else
     {
-        satMediaPlayer->setPosition(0);
-        satMediaPlayer->play();
+        pendingTriggers.remove(player);
+        player->stop();
     }
-    else if(toPlay == ShootSound)
+}
+
+void SoundEngine::trigger(QMediaPlayer* player)
+{
+    //A retrigger before the voice has started only keeps the last timestamp
+    qint64 now = clock.nsecsElapsed()/1000;
+
+    if(nullSink)
     {
-        shootMediaPlayer->setPosition(0);
-        shootMediaPlayer->play();
+        const NullVoice& voice = nullVoices.value(player);
+        pendingTriggers.insert(voice.sink, now);
+        voice.sink->stop();
+        voice.source->seek(0);
+        voice.sink->start(voice.source);
     }
-    else if(toPlay == SupernovaSound)
+    else
     {
-        snovaMediaPlayer->setPosition(0);
-        snovaMediaPlayer->play();
+        pendingTriggers.insert(player, now);
+        player->setPosition(0);
+        player->play();
     }
-	else if(toPlay == TrackingSound)
-	{
-		trackingMediaPlayer->setPosition(0);
-		trackingMediaPlayer->play();
-	}
-	else if(toPlay == AntiGravitySound)
-	{
-		antigravityMediaPlayer->setPosition(0);
-		antigravityMediaPlayer->play();
-	}
-	else if(toPlay == FreezeSound)
-	{
-		freezeMediaPlayer->setPosition(0);
-		freezeMediaPlayer->play();
-	}
 }
 
-void SoundEngine::stopSound(Sounds toPlay)
+void SoundEngine::voiceStarted(QObject* voice, qint64 position)
+{
+    QHash<QObject*, qint64>::iterator it = pendingTriggers.find(voice);
+    if(it == pendingTriggers.end())
+        return;
+
+    //position (ms) is the part of the voice already sent to the device when we are notified,
+    //so the first sample went out "position" ms before now
+    qint64 delay = clock.nsecsElapsed()/1000 - it.value() - position*1000;
+    latency.addSample(qMax(delay, Q_INT64_C(0)));
+    pendingTriggers.erase(it);
+}
+
+void SoundEngine::voicePositionChanged(qint64 position)
+{
+    if(position > 0)
+        voiceStarted(static_cast<QMediaPlayer*>(sender()), position);
+}
+
+void SoundEngine::voiceStatusChanged(QMediaPlayer::MediaStatus status)
+{
+    if(status == QMediaPlayer::StalledMedia)
+        ++underruns;
+}
+
+void SoundEngine::nullVoiceNotify()
+{
+    NullAudioSink* sink = static_cast<NullAudioSink*>(sender());
+    voiceStarted(sink, sink->processedUSecs()/1000);
+}
+
+void SoundEngine::nullVoiceStateChanged(QAudio::State state)
+{
+    if(state == QAudio::IdleState && static_cast<NullAudioSink*>(sender())->error() == QAudio::UnderrunError)
+        ++underruns;
+}
+
+void SoundEngine::setVolumes(int soundEffectsVolume, int musicVolume)
 {
-	if(toPlay == SatelliteSound)
-		satMediaPlayer->stop();
-	else if(toPlay == ShootSound)
-		shootMediaPlayer->stop();
-	else if(toPlay == SupernovaSound)
-		snovaMediaPlayer->stop();
-	else if(toPlay == TrackingSound)
-		trackingMediaPlayer->stop();
-	else if(toPlay == AntiGravitySound)
-		antigravityMediaPlayer->stop();
-	else if(toPlay == FreezeSound)
-		freezeMediaPlayer->stop();
-}
\ No newline at end of file
+    satMediaPlayer->setVolume(soundEffectsVolume);
+    shootMediaPlayer->setVolume(soundEffectsVolume);
+    snovaMediaPlayer->setVolume(soundEffectsVolume);
+    antigravityMediaPlayer->setVolume(soundEffectsVolume);
+    freezeMediaPlayer->setVolume(soundEffectsVolume);
+    trackingMediaPlayer->setVolume(soundEffectsVolume);
+    musicMediaPlayer->setVolume(musicVolume);
+}
+
+void SoundEngine::startMusic()
+{
+    if(!nullSink)
+        musicMediaPlayer->play();
+}
+
+void SoundEngine::stopMusic()
+{
+    if(!nullSink)
+        musicMediaPlayer->stop();
+}
+
+void SoundEngine::logStatistics() const
+{
+    qDebug() << "Sound trigger latency :" << latency.summary("us") << "underruns :" << underruns << (nullSink ? "(null sink)" : "");
+}
+
+void SoundEngine::resetStatistics()
+{
+    pendingTriggers.clear();
+    latency.clear();
+    underruns = 0;
+}
@@ -0,0 +1,118 @@
+#include "include/engine/SpawnController.h"
+#include "include/config/Define.h"
+
+#include <cstring>
+
+namespace
+{
+const qreal kSmoothing = 0.1;
+
+//Shedding rank and cap of living items of each category
+struct CategoryLimit
+{
+    Difficulty category;
+    const char* name;
+    int rank;
+    int cap;
+};
+
+const CategoryLimit kLimits[] =
+{
+    {Satellites,        "satellite",        1, SPAWN_CAP_SATELLITES},
+    {Supernovae,        "supernova",        1, SPAWN_CAP_SUPERNOVAE},
+    {Asteroids,         "asteroid",         2, SPAWN_CAP_ASTEROIDS},
+    {AlienMothership,   "alien mothership", 3, SPAWN_CAP_ALIENS},
+    {BlackSquadron,     "black squadron",   3, SPAWN_CAP_BLACKSHIPS}
+};
+const int kNbLimits = sizeof(kLimits)/sizeof(kLimits[0]);
+}
+
+SpawnController::SpawnController()
+    :targetPeriod(REFRESH*1000.0),averagePeriod(0),averageCost(0),nbTicks(0),level(0)
+{
+    static_assert(sizeof(kLimits)/sizeof(kLimits[0]) == kNbCategories, "one rejection counter per category");
+    memset(rejections, 0, sizeof(rejections));
+}
+
+void SpawnController::tickStarted()
+{
+    if(periodClock.isValid())
+    {
+        qreal l_period = periodClock.nsecsElapsed()/1000.0;
+        averagePeriod = averagePeriod == 0 ? l_period : averagePeriod+kSmoothing*(l_period-averagePeriod);
+    }
+    periodClock.start();
+    costClock.start();
+}
+
+void SpawnController::tickFinished()
+{
+    qreal l_cost = costClock.nsecsElapsed()/1000.0;
+    averageCost = averageCost == 0 ? l_cost : averageCost+kSmoothing*(l_cost-averageCost);
+
+    if(++nbTicks >= SPAWN_CONTROL_TICKS)
+    {
+        nbTicks = 0;
+        evaluate();
+    }
+}
+
+void SpawnController::pause()
+{
+    periodClock.invalidate();
+
+    QString l_rejections = takeRejections();
+    if(!l_rejections.isEmpty())
+        qDebug() << "Spawn controller : load level" << level << "," << qPrintable(l_rejections);
+}
+
+void SpawnController::evaluate()
+{
+    bool l_overloaded = averagePeriod > targetPeriod*SPAWN_OVERLOAD_RATIO || averageCost > targetPeriod*SPAWN_OVERLOAD_COST;
+    bool l_recovered = averagePeriod < targetPeriod*SPAWN_RECOVER_RATIO && averageCost < targetPeriod*SPAWN_OVERLOAD_COST/2.0;
+
+    int l_level = level;
+    if(l_overloaded && level < SPAWN_LOAD_LEVELS-1)
+        level++;
+    else if(l_recovered && level > 0)
+        level--;
+
+    if(l_level != level)
+        qDebug() << "Spawn controller : load level" << l_level << "->" << level
+                 << "frame" << averagePeriod/1000.0 << "ms tick" << averageCost/1000.0 << "ms"
+                 << qPrintable(takeRejections());
+}
+
+QString SpawnController::takeRejections()
+{
+    QStringList l_parts;
+    for(int i = 0;i<kNbLimits;i++)
+        if(rejections[i] > 0)
+        {
+            l_parts << QString("%1 refused %2 times").arg(kLimits[i].name).arg(rejections[i]);
+            rejections[i] = 0;
+        }
+
+    return l_parts.join(", ");
+}
+
+qreal SpawnController::spawnFactor() const
+{
+    return 1.0-level*SPAWN_FACTOR_STEP;
+}
+
+bool SpawnController::allows(Difficulty _category, int _nbAlive)
+{
+    for(int i = 0;i<kNbLimits;i++)
+        if(kLimits[i].category == _category)
+        {
+            if(level < kLimits[i].rank || _nbAlive < kLimits[i].cap)
+                return true;
+
+            //Counted only, allows() runs for every spawn attempt
+            rejections[i]++;
+            return false;
+        }
+
+    return true;
+}
@@ -14,7 +14,7 @@
 
 #define arccot M_PI / 2.0 - atan
 
-SpawnEngine::SpawnEngine(int difficulty, GameEngine *_ge, bool _isDemo):isDemo(_isDemo)
+SpawnEngine::SpawnEngine(int difficulty, GameEngine *_ge, bool _isDemo):spawnController(_ge->spawnController()),isDemo(_isDemo)
 {
     this->ge = _ge;
     this->de = _ge->displayEngine();
@@ -60,20 +60,34 @@ void SpawnEngine::start()
 void SpawnEngine::timerFired()
 {
     double probSpawn = (isDemo) ? 0.5 : proba(ge->elapsedTime() / 1000.0);
+    probSpawn *= spawnController.spawnFactor();
 
     if(ge->randDouble() < probSpawn)
     {
         int probWhat = ge->randInt(totalProba);
 
+        Difficulty category = BlackSquadron;
+        if(probWhat < intervalAsteroid)
+            category = Asteroids;
+        else if(probWhat < intervalAlien)
+            category = AlienMothership;
+        else if(probWhat < intervalSat)
+            category = Satellites;
+        else if(probWhat < intervalSupernova)
+            category = Supernovae;
+
+        if(!spawnController.allows(category, ge->nbAlive(category)))
+            return;
+
         if(probWhat < intervalAsteroid)
         {
-            Asteroid *asteroid = new Asteroid(0, 0, Other, RESISTANCE_ASTEROID, MAX_SPACESHIP_PV, ge);
+            Asteroid *asteroid = new (ge->matchArena()) Asteroid(0, 0, Other, RESISTANCE_ASTEROID, MAX_SPACESHIP_PV, ge);
             ge->addAsteroid(asteroid);
         }
         else if(probWhat < intervalAlien)
         {
             int nbSpirales = irand(ALIEN_SWIRL_MIN, ALIEN_SWIRL_MAX);
-            AlienSpaceship *alien = new AlienSpaceship(nbSpirales, MAX_SPACESHIP_PV, RESISTANCE_ALIEN, ge);
+            AlienSpaceship *alien = new (ge->matchArena()) AlienSpaceship(nbSpirales, MAX_SPACESHIP_PV, RESISTANCE_ALIEN, ge);
             ge->addAlienSpaceship(alien);
         }
         else if(probWhat < intervalSat)
@@ -100,17 +114,17 @@ Bonus* SpawnEngine::generateBonus()
     switch(satType)
     {
     case 1:
-        bonus = new BonusForceField(ge);
+        bonus = new (ge->matchArena()) BonusForceField(ge);
         break;
     case 2:
-        bonus = new BonusHP(irand(BONUS_HEALTH_MIN, BONUS_HEALTH_MAX), ge);
+        bonus = new (ge->matchArena()) BonusHP(irand(BONUS_HEALTH_MIN, BONUS_HEALTH_MAX), ge);
         break;
     case 3:
     case 4:
-        bonus = new BonusProjectile((TypeProjectiles)irand(BONUS_TYPE_PROJECTILES_MIN, BONUS_TYPE_PROJECTILES_MAX), BONUS_PROJECTILE_DURATION, ge);
+        bonus = new (ge->matchArena()) BonusProjectile((TypeProjectiles)irand(BONUS_TYPE_PROJECTILES_MIN, BONUS_TYPE_PROJECTILES_MAX), BONUS_PROJECTILE_DURATION, ge);
         break;
     case 5:
-        bonus = new BonusInvicibility(BONUS_INVICIBILITY_DURATION, ge);
+        bonus = new (ge->matchArena()) BonusInvicibility(BONUS_INVICIBILITY_DURATION, ge);
         break;
     }
 
@@ -120,7 +134,10 @@ Bonus* SpawnEngine::generateBonus()
 void SpawnEngine::pause(bool isPause)
 {
     if(isPause)
+    {
         timer->stop();
+        spawnController.pause();
+    }
     else
         timer->start();
 }
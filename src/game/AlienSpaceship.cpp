@@ -20,11 +20,12 @@
 
 #include "include/game/AlienSpaceship.h"
 #include "include/game/ProjectileAlien.h"
+#include "include/utils/SpriteCache.h"
 
 const qreal AlienSpaceship::kIntervalArgument = ARG_INCREMENTATION_ALIENSPACESHIP;
 
 AlienSpaceship::AlienSpaceship(int _nbSpirales,qreal _dHealthPoint,qreal _dResistance,GameEngine* _gameEngine)
-    :Displayable(0,0,new QPixmap(PICTURE_ALIENSPACESHIP)),
+    :Displayable(0,0,&SpriteCache::pixmap(PICTURE_ALIENSPACESHIP)),
       Destroyable(_dHealthPoint,_dResistance),
       gameEngine(_gameEngine),//GameEngine
       nbSpirales(_nbSpirales),//Number of spirales that will be fired
@@ -108,7 +109,7 @@ AlienSpaceship::AlienSpaceship(int _nbSpirales,qreal _dHealthPoint,qreal _dResis
         l_y1=gameEngine->sceneSize().height();
         l_y3=gameEngine->sceneSize().y();
         //Rotate the picture if it's coming by the bottom size
-        Displayable::setPixmap(new QPixmap(getPixmap()->transformed(QTransform().rotate(180))));
+        Displayable::setPixmap(&SpriteCache::rotated(*getPixmap(), 180.0));
 		turnShadow();
     }
 
@@ -132,6 +133,7 @@ AlienSpaceship::AlienSpaceship(int _nbSpirales,qreal _dHealthPoint,qreal _dResis
 
     dModule = sqrt((l_x1-dX0)*(l_x1-dX0)+(l_y1-dY0)*(l_y1-dY0));
     dArgument = atan((dY0-l_y1)/(l_x1-dX0));
+    arc.reset(dArgument, directionArg*kIntervalArgument);
 
     setPos(l_x1,l_y1);
 }
@@ -156,10 +158,17 @@ void AlienSpaceship::advance(int _step)
 
         dArgument+=directionArg*kIntervalArgument;
 
+        //Once it has fired the step grows every tick, so the arc is evaluated directly
         if(hasAttacked)
+        {
             dArgument*=1.01;
-        setPos(dX0+directionX*dModule*cos(dArgument)
-               ,dY0-directionY*dModule*sin(dArgument));
+            arc.setArgument(dArgument);
+        }
+        else
+            arc.next();
+
+        setPos(dX0+directionX*dModule*arc.cosine()
+               ,dY0-directionY*dModule*arc.sine());
     }
 }
 
@@ -169,7 +178,7 @@ void AlienSpaceship::attacking()
 
     //Shoot the projectiles
     for(int i = 0;i<nbSpirales;i++)
-        gameEngine->addProjectile(new ProjectileAlien(pos().x()+getPixmap()->width()/2,pos().y()+getPixmap()->height()/2,Alien,static_cast<double>(2*M_PI)/nbSpirales*(i+1),0));
+        gameEngine->spawnLater(new (gameEngine->matchArena()) ProjectileAlien(pos().x()+getPixmap()->width()/2,pos().y()+getPixmap()->height()/2,Alien,static_cast<double>(2*M_PI)/nbSpirales*(i+1),0), SpawnQueue::ToProjectiles);
 
     hasAttacked=true;
     isAttacking=false;
@@ -187,9 +196,7 @@ QRectF AlienSpaceship::boundingRect() const
 
 QPainterPath AlienSpaceship::shape() const
 {
-    QPainterPath l_path;
-    l_path.addEllipse(boundingRect());
-    return l_path;
+    return ellipseShape(boundingRect());
 }
 
 void AlienSpaceship::paint(QPainter *_painter,const QStyleOptionGraphicsItem *, QWidget *)
@@ -19,6 +19,8 @@
 #include "include/engine/GameEngine.h"
 
 #include "include/game/Asteroid.h"
+#include "include/game/DeathQueue.h"
+#include "include/utils/SpriteCache.h"
 
 Asteroid::Asteroid(qreal _dX, qreal _dY,Shooter _from, qreal _dResistance, qreal _dHealthPoint,GameEngine *_gameEngine,int _idParent, qreal _dAngle ,qreal _dSpeedParent)
     : Destroyable(_dHealthPoint,_dResistance),
@@ -43,7 +45,7 @@ Asteroid::Asteroid(qreal _dX, qreal _dY,Shooter _from, qreal _dResistance, qreal
         currentFrame = numberFrameMin;
 
         dPower = POWER_SMALL_ASTEROID;
-        setPixmap(new QPixmap(QString(PICTURE_SMALL_ASTEROID).arg(currentFrame)));
+        setPixmap(&SpriteCache::pixmap(QString(PICTURE_SMALL_ASTEROID).arg(currentFrame)));
     }
     else
     {
@@ -54,7 +56,7 @@ Asteroid::Asteroid(qreal _dX, qreal _dY,Shooter _from, qreal _dResistance, qreal
         dSpeed = SPEED_ASTEROID;
 		dSpeed *= (GameEngine::randDouble()+0.5);
         dPower = POWER_ASTEROID;
-        setPixmap(new QPixmap(QString(PICTURE_ASTEROID).arg(currentFrame)));
+        setPixmap(&SpriteCache::pixmap(QString(PICTURE_ASTEROID).arg(currentFrame)));
 
         QRect sceneSize = gameEngine->sceneSize();
 
@@ -109,42 +111,51 @@ Asteroid::Asteroid(qreal _dX, qreal _dY,Shooter _from, qreal _dResistance, qreal
 
 void Asteroid::collision(qreal _dAngle)
 {
+    //The asteroid is deleted right after, the splinters are created by the engine at the end of the tick
     if(!bSmall)
     {
-        int l_nb = gameEngine->randInt(MAX_ASTEROID-MIN_ASTEROID)+MIN_ASTEROID;
-        static int l_id = 1;//Parent ID
+        SplinterEvent l_event;
+        l_event.centre = QPointF(pos().x()+getPixmap()->width()/2.0,pos().y()+getPixmap()->height()/2.0);
+        l_event.parentAngle = dAngle;
+        l_event.hitAngle = _dAngle;
+        l_event.speed = dSpeed;
+        gameEngine->tickDeaths().pushSplinters(l_event);
+    }
+}
 
-        qreal l_dAngle = (_dAngle+dAngle)/2.0-M_PI/2.0;
-        qreal l_dDeltaA = DELTA_ANGLE_BETWEEN_180_AXES;
-        qreal l_dAngle2 = static_cast<double>(M_PI-l_dDeltaA)/(l_nb-1);
+void Asteroid::createSplinters(GameEngine* _gameEngine, const SplinterEvent& _event)
+{
+    int l_nb = _gameEngine->randInt(MAX_ASTEROID-MIN_ASTEROID)+MIN_ASTEROID;
+    static int l_id = 1;//Parent ID
 
-        //We add the good angle for the small asteroids go in the good direction
-        if(cos(_dAngle)<0)
-        {
-            if(cos(dAngle)>0)
-                l_dAngle-=M_PI/2.0;
-        }
-        else
-            if(cos(dAngle)<0)
-                l_dAngle+=M_PI/2.0;
+    qreal l_dAngle = (_event.hitAngle+_event.parentAngle)/2.0-M_PI/2.0;
+    qreal l_dDeltaA = DELTA_ANGLE_BETWEEN_180_AXES;
+    qreal l_dAngle2 = static_cast<double>(M_PI-l_dDeltaA)/(l_nb-1);
 
-        for(int i = 0;i<l_nb;i++)
-            gameEngine->addSmallAsteroid(new Asteroid(pos().x()+getPixmap()->width()/2.0,pos().y()+getPixmap()->height()/2.0,
-                                                      Other,RESISTANCE_SMALL_ASTEROID,HEALTHPOINT_SMALL_ASTEROID,gameEngine,l_id,l_dAngle+l_dAngle2*i+l_dDeltaA/2.0, dSpeed));
-        l_id++;
+    //We add the good angle for the small asteroids go in the good direction
+    if(cos(_event.hitAngle)<0)
+    {
+        if(cos(_event.parentAngle)>0)
+            l_dAngle-=M_PI/2.0;
     }
+    else
+        if(cos(_event.parentAngle)<0)
+            l_dAngle+=M_PI/2.0;
+
+    for(int i = 0;i<l_nb;i++)
+        _gameEngine->addSmallAsteroid(new (_gameEngine->matchArena()) Asteroid(_event.centre.x(),_event.centre.y(),
+                                                  Other,RESISTANCE_SMALL_ASTEROID,HEALTHPOINT_SMALL_ASTEROID,_gameEngine,l_id,l_dAngle+l_dAngle2*i+l_dDeltaA/2.0, _event.speed));
+    l_id++;
 }
 
 QRectF Asteroid::boundingRect() const
 {
-    return QRectF(getPixmap()->rect());
+    return spriteTransform().mapRect(QRectF(getPixmap()->rect()));
 }
 
 QPainterPath Asteroid::shape() const
 {
-    QPainterPath l_path;
-    l_path.addEllipse(boundingRect());
-    return l_path;
+    return spriteEllipseShape(QRectF(getPixmap()->rect()));
 }
 
 void Asteroid::paint(QPainter* _painter,const QStyleOptionGraphicsItem*, QWidget*)
@@ -156,9 +167,9 @@ void Asteroid::paint(QPainter* _painter,const QStyleOptionGraphicsItem*, QWidget
             currentFrame=numberFrameMin;
 
         if(bSmall)
-            setPixmap(new QPixmap(QString(PICTURE_SMALL_ASTEROID).arg(++currentFrame)));
+            setPixmap(&SpriteCache::pixmap(QString(PICTURE_SMALL_ASTEROID).arg(++currentFrame)));
         else
-            setPixmap(new QPixmap(QString(PICTURE_ASTEROID).arg(++currentFrame)));
+            setPixmap(&SpriteCache::pixmap(QString(PICTURE_ASTEROID).arg(++currentFrame)));
     }
-    _painter->drawPixmap(0,0,*getPixmap());
+    drawSprite(_painter, *getPixmap());
 }
@@ -22,11 +22,12 @@
 
 #include "include/game/Bonus.h"
 #include "include/game/Spaceship.h"
+#include "include/utils/SpriteCache.h"
 
 const qreal Bonus::kIntervalArgument = ARG_INCREMENTATION_BONUS;
 
 Bonus::Bonus(TypeBonus _bonus, GameEngine *_gameEngine)
-    :Displayable(0,0,new QPixmap(PICTURE_BONUS)),
+    :Displayable(0,0,&SpriteCache::pixmap(PICTURE_BONUS)),
       gameEngine(_gameEngine),//GameEngine
       directionX(1),//Default X-direction
       directionY(1),//Default Y-direction
@@ -94,7 +95,7 @@ Bonus::Bonus(TypeBonus _bonus, GameEngine *_gameEngine)
         l_y1=gameEngine->sceneSize().height();
         l_y3=gameEngine->sceneSize().y();
         //Rotate the picture if it's coming by the bottom size
-        Displayable::setPixmap(new QPixmap(getPixmap()->transformed(QTransform().rotate(180))));
+        Displayable::setPixmap(&SpriteCache::rotated(*getPixmap(), 180.0));
     }
 
     //Change Y location if the case where the Bonus comes by the top,
@@ -110,6 +111,7 @@ Bonus::Bonus(TypeBonus _bonus, GameEngine *_gameEngine)
 
     dModule = sqrt((l_x1-dX0)*(l_x1-dX0)+(l_y1-dY0)*(l_y1-dY0));
     dArgument = atan((dY0-l_y1)/(l_x1-dX0));
+    arc.reset(dArgument, directionArg*kIntervalArgument);
 
     setPos(l_x1,l_y1);
 }
@@ -124,9 +126,10 @@ void Bonus::advance(int _step)
         return;
 
     dArgument+=directionArg*kIntervalArgument;
+    arc.next();
 
-    setPos(dX0+directionX*dModule*cos(dArgument)
-           ,dY0-directionY*dModule*sin(dArgument));
+    setPos(dX0+directionX*dModule*arc.cosine()
+           ,dY0-directionY*dModule*arc.sine());
 }
 
 QRectF Bonus::boundingRect() const
@@ -136,9 +139,7 @@ QRectF Bonus::boundingRect() const
 
 QPainterPath Bonus::shape() const
 {
-    QPainterPath l_path;
-    l_path.addEllipse(boundingRect());
-    return l_path;
+    return ellipseShape(boundingRect());
 }
 
 void Bonus::paint(QPainter *_painter,const QStyleOptionGraphicsItem *, QWidget *)
@@ -0,0 +1,24 @@
+#include "include/game/DeathQueue.h"
+
+void DeathQueue::push(Destroyable* _item, int _nbPoint, Shooter _forShip)
+{
+    DeathEvent l_event;
+    l_event.item = _item;
+    l_event.nbPoint = _nbPoint;
+    l_event.forShip = _forShip;
+    events.append(l_event);
+}
+
+void DeathQueue::clear()
+{
+    events.clear();
+    splinters.clear();
+    graveyard.clear();
+}
+
+void DeathQueue::cancel(Destroyable* _item)
+{
+    for(auto it = events.begin(); it != events.end(); ++it)
+        if(it->item == _item)
+            it->item = 0;
+}
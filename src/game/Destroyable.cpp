@@ -16,14 +16,24 @@
  *==============================================================*/
 
 #include "include/game/Destroyable.h"
+#include "include/game/DeathQueue.h"
 
 Destroyable::Destroyable(qreal _dHealthPoint,qreal _dResistance)
-    :QObject(),
-      dHealthPoint(_dHealthPoint),//Health Point
-      dResistance(_dResistance)//Resistance
+    :dHealthPoint(_dHealthPoint),//Health Point
+      dResistance(_dResistance),//Resistance
+      pointToGive(0),
+      forShip(Other),
+      deathQueue(0),
+      bDying(false)
 {
 }
 
+Destroyable::~Destroyable()
+{
+    if(bDying && deathQueue != 0)
+        deathQueue->cancel(this);
+}
+
 void Destroyable::receiveAttack(qreal _dPower, int _point, Shooter _forShip)
 {
     this->pointToGive = _point;
@@ -45,6 +55,11 @@ bool Destroyable::gonnaDead(qreal _dPower)
 
 void Destroyable::isDead()
 {
-    if(dHealthPoint<1.0)
-        emit destroyed(this,pointToGive,forShip);
+    //Reported once, the following hits of the same tick don't kill it again
+    if(dHealthPoint<1.0 && !bDying)
+    {
+        bDying = true;
+        if(deathQueue != 0)
+            deathQueue->push(this,pointToGive,forShip);
+    }
 }
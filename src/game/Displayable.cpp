@@ -15,13 +15,15 @@
  *==============================================================*/
 
 #include "include/game/Displayable.h"
+#include "include/utils/MatchArena.h"
+#include "include/utils/SpriteCache.h"
 
-Displayable::Displayable(qreal _dX, qreal _dY, QPixmap* _pixmap)
+Displayable::Displayable(qreal _dX, qreal _dY, const QPixmap* _pixmap)
     :nbPoint(0),//Number of point
       dX(_dX),//X coordinate
       dY(_dY),//Y coordinate
-      pxmPicture(_pixmap)//Picture
-
+      pxmPicture(_pixmap),//Picture
+      spriteAngle(0)
 {
     dAngle = 0;
     setPos(dX,dY);
@@ -29,7 +31,26 @@ Displayable::Displayable(qreal _dX, qreal _dY, QPixmap* _pixmap)
 
 Displayable::~Displayable()
 {
-    delete pxmPicture;
+}
+
+void* Displayable::operator new(size_t _size, MatchArena& _arena)
+{
+    return MatchArena::allocateTagged(&_arena, _size);
+}
+
+void* Displayable::operator new(size_t _size)
+{
+    return MatchArena::allocateTagged(0, _size);
+}
+
+void Displayable::operator delete(void* _p, MatchArena&)
+{
+    MatchArena::freeTagged(_p);
+}
+
+void Displayable::operator delete(void* _p)
+{
+    MatchArena::freeTagged(_p);
 }
 
 void Displayable::setPos(qreal _dX, qreal _dY)
@@ -39,9 +60,73 @@ void Displayable::setPos(qreal _dX, qreal _dY)
     QGraphicsItem::setPos(dX,dY);
 }
 
-void Displayable::setPixmap(QPixmap *_pxmPixmap)
+QPainterPath Displayable::ellipseShape(const QRectF& _rect) const
+{
+    if(shapePath.isEmpty() || _rect != shapeRect || !shapeMatrix.isIdentity())
+    {
+        shapePath = QPainterPath();
+        shapePath.addEllipse(_rect);
+        shapeRect = _rect;
+        shapeMatrix = QTransform();
+    }
+    return shapePath;//Implicitly shared, no copy of the elements
+}
+
+QPainterPath Displayable::spriteEllipseShape(const QRectF& _spriteRect) const
+{
+    if(shapePath.isEmpty() || _spriteRect != shapeRect || spriteMatrix != shapeMatrix)
+    {
+        QPainterPath l_ellipse;
+        l_ellipse.addEllipse(_spriteRect);
+        shapePath = spriteMatrix.map(l_ellipse);
+        shapeRect = _spriteRect;
+        shapeMatrix = spriteMatrix;
+    }
+    return shapePath;
+}
+
+void Displayable::setSpriteRotation(qreal _degrees)
+{
+    prepareGeometryChange();
+    spriteAngle = _degrees;
+    spriteMatrix = spriteBase*QTransform().rotate(spriteAngle);
+}
+
+void Displayable::setSpriteTransform(const QTransform& _transform)
+{
+    Q_ASSERT_X(_transform.type() <= QTransform::TxRotate && qFuzzyCompare(_transform.determinant(), 1.0),
+               "Displayable", "drawSprite() only blits rotated sprites, no scale, mirror or shear");
+    prepareGeometryChange();
+    spriteBase = _transform;
+    spriteMatrix = spriteBase*QTransform().rotate(spriteAngle);
+}
+
+void Displayable::drawSprite(QPainter* _painter, const QPixmap& _sprite) const
+{
+    QPointF l_topLeft;
+    const QPixmap& l_blit = spriteBlit(_sprite, l_topLeft);
+    _painter->drawPixmap(l_topLeft, l_blit);
+}
+
+const QPixmap& Displayable::spriteBlit(const QPixmap& _sprite, QPointF& _topLeft) const
+{
+    if(spriteMatrix.isIdentity())
+    {
+        _topLeft = QPointF(0, 0);
+        return _sprite;
+    }
+
+    //The sprite is rotated around its center, which must end where the transform puts it.
+    //Drawn on an integer position with an identity transform, it's a plain blit.
+    //Only the angle is kept, setSpriteTransform() made sure there is nothing else
+    qreal degrees = atan2(spriteMatrix.m12(), spriteMatrix.m11())*180.0/M_PI;
+    const QPixmap& rotated = SpriteCache::rotated(_sprite, degrees);
+    QPointF center = spriteMatrix.map(QPointF(_sprite.width()/2.0, _sprite.height()/2.0));
+    _topLeft = (center-QPointF(rotated.width()/2.0, rotated.height()/2.0)).toPoint();
+    return rotated;
+}
+
+void Displayable::setPixmap(const QPixmap *_pxmPixmap)
 {
-    if(pxmPicture!=0)
-        delete pxmPicture;
     pxmPicture = _pxmPixmap;
 }
@@ -0,0 +1,32 @@
+#include "include/game/LinearProjectile.h"
+
+namespace
+{
+    //Constant data, initialized before any code runs
+    const LinearKindParameters kLinearKinds[NbLinearKinds] =
+    {
+        //power  speed (dx)  mirrored
+        {1000,   25,         true},     //SimpleKind, the spaceships' default
+        {600,    25,         true},     //CrossKind, three of them by SLOPE_CROSS
+        {500,    30,         false}     //BlackKind, the blackships shoot with absolute angles
+    };
+}
+
+LinearProjectile::LinearProjectile(LinearKind _kind, qreal _dXOrigin, qreal _dYOrigin, Shooter _from, qreal _dAngle)
+    :Projectile(_dXOrigin,_dYOrigin,_from)
+{
+    const LinearKindParameters& l_parameters = parameters(_kind);
+    dPower = l_parameters.power;
+    dSpeed = l_parameters.speed;
+    dAngle = -_dAngle;
+
+    if(l_parameters.mirrored && _from==Player2)
+        dAngle+=M_PI;
+
+    loadPixmap();
+}
+
+const LinearKindParameters& LinearProjectile::parameters(LinearKind _kind)
+{
+    return kLinearKinds[_kind];
+}
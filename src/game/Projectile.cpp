@@ -17,6 +17,8 @@
 
 #include "include/game/Projectile.h"
 #include "include/config/Define.h"
+#include "include/utils/SpriteCache.h"
+#include "include/game/ProjectileStore.h"
 
 Projectile::Projectile(qreal _dXOrigin, qreal _dYOrigin,Shooter _from)
     :Displayable(_dXOrigin,_dYOrigin),
@@ -24,45 +26,43 @@ Projectile::Projectile(qreal _dXOrigin, qreal _dYOrigin,Shooter _from)
       dYOrigin(_dYOrigin),//Y-Origin where the projectile was shot
       from(_from),//Who has shot it
       antiGravity(false),
-      image(0)
+      image(0),
+      store(0),
+      storeSlot(-1)
 {
     nbPoint = NB_POINT_PROJECTILE;
     if(from == Player1)
     {
-        color = new QColor(0,0,255);
+        color = QColor(0,0,255);
         dAngle = 0;
     }
     else if(from == Player2)
     {
-        color = new QColor(255,0,0);
+        color = QColor(255,0,0);
         dAngle = M_PI;
     }
     else
-        color = new QColor(qrand() % 256, qrand() % 256, qrand() % 256);
+        color = QColor(qrand() % 256, qrand() % 256, qrand() % 256);
 }
 
 void Projectile::loadPixmap()
 {
-    if(image != 0)
-        delete image;
-
     if(from == Player1)
-        image = new QPixmap(PICTURE_PROJ_SPACESHIP_1);
+        image = &SpriteCache::pixmap(PICTURE_PROJ_SPACESHIP_1);
     else if(from == Player2)
-        image = new QPixmap(PICTURE_PROJ_SPACESHIP_2);
+        image = &SpriteCache::pixmap(PICTURE_PROJ_SPACESHIP_2);
     else if(from == Black)
-        image = new QPixmap(PICTURE_PROJ_BLACKSHIP);
+        image = &SpriteCache::pixmap(PICTURE_PROJ_BLACKSHIP);
     else
-        image = new QPixmap(PICTURE_PROJ_SPACESHIP_3);
+        image = &SpriteCache::pixmap(PICTURE_PROJ_SPACESHIP_3);
 
-    setRotation(-dAngle*180.0/M_PI);
+    setSpriteRotation(-dAngle*180.0/M_PI);
 }
 
 Projectile::~Projectile()
 {
-    delete color;
-    if(image != 0)
-        delete image;
+    if(store != 0)
+        store->remove(this);
 }
 
 void Projectile::enableAntiGravity(Shooter playerActivated)
@@ -71,7 +71,7 @@ void Projectile::enableAntiGravity(Shooter playerActivated)
     {
         if(playerActivated == Player1 && cos(dAngle) < 0 || playerActivated == Player2 && cos(dAngle) >= 0)
         {
-            setRotation(180.0);
+            setSpriteRotation(180.0);
             dAngle += M_PI;
         }
         dSpeed *= SPEED_FACTOR_ANTI_GRAVITY;
@@ -86,27 +86,32 @@ void Projectile::enableAntiGravity(Shooter playerActivated)
 
 QRectF Projectile::boundingRect() const
 {
-    return QRectF(image->width()-15,image->height()/2.0-5,10,10);
+    return spriteTransform().mapRect(QRectF(image->width()-15,image->height()/2.0-5,10,10));
 }
 
 QPainterPath Projectile::shape() const
 {
-    QPainterPath l_path;
-    l_path.addEllipse(image->width()-15,image->height()/2.0-5,10,10);
-    return l_path;
+    return spriteEllipseShape(QRectF(image->width()-15,image->height()/2.0-5,10,10));
 }
 
 void Projectile::paint(QPainter *_painter, const QStyleOptionGraphicsItem *, QWidget *)
 {
-    _painter->setBrush(*color);
+    _painter->setBrush(color);
     if(image != 0)
-        _painter->drawPixmap(0, 0,*image);
+        drawSprite(_painter, *image);
+}
+
+QPointF Projectile::velocity() const
+{
+    return QPointF(dSpeed*cos(dAngle),-dSpeed*sin(dAngle));
 }
 
 void Projectile::advance(int _step)
 {
-    if (!_step)
+    //A stored projectile is out of the scene, ProjectileStore::advance() moves it with the others
+    if (!_step || store != 0)
         return;
 
-    moveBy(dSpeed*cos(dAngle),-dSpeed*sin(dAngle));
+    QPointF l_velocity = velocity();
+    moveBy(l_velocity.x(),l_velocity.y());
 }
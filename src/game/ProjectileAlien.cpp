@@ -16,6 +16,7 @@
  *==============================================================*/
 
 #include "include/game/ProjectileAlien.h"
+#include "include/game/LinearProjectile.h"
 
 #include "include/config/Define.h"
 
@@ -27,10 +28,18 @@ ProjectileAlien::ProjectileAlien(qreal _dXOrigin, qreal _dYOrigin,Shooter _from,
       dModule(_dModule)//Module
 {
     dAngle = _dArgument;
+    cosAngle = cos(dAngle);
+    sinAngle = sin(dAngle);
     dPower = POWER_ALIEN;
     loadPixmap();
 }
 
+QPointF ProjectileAlien::velocity() const
+{
+    //Not the cached direction, enableAntiGravity() has turned dAngle to 0 or PI
+    return QPointF(LinearProjectile::parameters(SimpleKind).speed*SPEED_FACTOR_ANTI_GRAVITY*0.75*cos(dAngle), 0);
+}
+
 void ProjectileAlien::advance(int _step)
 {
     if (!_step)
@@ -39,7 +48,7 @@ void ProjectileAlien::advance(int _step)
     dModule+=ProjectileAlien::kIntervalModule;
 
     if(antiGravity)
-        moveBy(SPEED_SIMPLE_DEF*SPEED_FACTOR_ANTI_GRAVITY*0.75*cos(dAngle), 0);
+        Projectile::advance(_step);
     else
-        setPos(dXOrigin+dModule*cos(dAngle), dYOrigin-dModule*sin(dAngle));
+        setPos(dXOrigin+dModule*cosAngle, dYOrigin-dModule*sinAngle);
 }
@@ -1,5 +1,6 @@
 #include "include/game/ProjectileGuided.h"
 #include "include/config/Define.h"
+#include "include/utils/SpriteCache.h"
 #include "include/game/Spaceship.h"
 
 ProjectileGuided::ProjectileGuided(qreal _dXOrigin, qreal _dYOrigin, Shooter _from, Spaceship *_spaceship)
@@ -12,8 +13,8 @@ ProjectileGuided::ProjectileGuided(qreal _dXOrigin, qreal _dYOrigin, Shooter _fr
     if(from == Player2)
         dAngle += M_PI;
 
-    image = new QPixmap(PICTURE_PROJ_GUIDED);
-    setRotation(-dAngle*180.0/M_PI);
+    image = &SpriteCache::pixmap(PICTURE_PROJ_GUIDED);
+    setSpriteRotation(-dAngle*180.0/M_PI);
 }
 
 ProjectileGuided::~ProjectileGuided()
@@ -2,7 +2,7 @@
 #include "include/config/Define.h"
 
 ProjectileMulti::ProjectileMulti(qreal _dXOrigin, qreal _dYOrigin, Shooter _from, qreal _coeff, qreal _power, qreal _dAngle)
-    :Projectile(_dXOrigin, _dYOrigin, _from),coeff(_coeff),power(_power)
+    :Projectile(_dXOrigin, _dYOrigin, _from),coeff(_coeff),power(_power),nbSteps(0),powers(_power)
 {
     dAngle = -_dAngle;
     dPower = POWER_MULTI;
@@ -11,6 +11,10 @@ ProjectileMulti::ProjectileMulti(qreal _dXOrigin, qreal _dYOrigin, Shooter _from
     if(from == Player2)
         dAngle += M_PI;
 
+    //After n ticks |x-x0| = n*|stepX|, so |x-x0|^power = |stepX|^power * n^power
+    stepX = dSpeed*cos(dAngle);
+    scale = dSpeed*coeff*pow(fabs(stepX), power);
+
     loadPixmap();
 }
 
@@ -24,25 +28,25 @@ void ProjectileMulti::advance(int _step)
         Projectile::advance(_step);
     else
     {
-        resetTransform();
-        qreal x = dSpeed*cos(dAngle);
-        qreal y = -dSpeed*coeff*pow(abs(pos().x()-dXOrigin), power);
+        qreal x = stepX;
+        qreal y = -scale*powers.at(nbSteps);
+        nbSteps++;
         setPos(pos().x()+x, dYOrigin+y);
 
         if(from == Player1)
-            setRotation(-2*dAngle*180.0/M_PI);
+            setSpriteRotation(-2*dAngle*180.0/M_PI);
         else
-            setRotation(180.0);
+            setSpriteRotation(180.0);
 
         x = pos().x();
         y = 0;
 
         if(from == Player1)
-            setTransform(QTransform().translate(x,y).rotateRadians(dAngle).translate(-x,-y));
+            setSpriteTransform(QTransform().translate(x,y).rotateRadians(dAngle).translate(-x,-y));
         else
         {
             x = dXOrigin-pos().x();
-            setTransform(QTransform().translate(x,y).rotateRadians(M_PI-dAngle).translate(-x,-y));
+            setSpriteTransform(QTransform().translate(x,y).rotateRadians(M_PI-dAngle).translate(-x,-y));
         }
     }
 }
@@ -0,0 +1,249 @@
+#include "include/game/ProjectileStore.h"
+#include "include/game/Projectile.h"
+
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QPainter>
+
+//The vector path works on qreal, which is a double unless Qt was built with another coordinate type
+#if !defined(QT_COORD_TYPE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PROJECTILE_STORE_SSE2
+#include <emmintrin.h>
+#endif
+
+//Draws every stored projectile, the scene only sees this item
+class ProjectileLayer : public QGraphicsItem
+{
+public:
+    //Above the other entities, where the projectiles mostly were as they are added after them
+    explicit ProjectileLayer(ProjectileStore* _store) :store(_store) {setZValue(1);}
+    ~ProjectileLayer()
+    {
+        if(store != 0)
+            store->layer = 0;
+    }
+
+    QRectF boundingRect() const {return scene() != 0 ? scene()->sceneRect() : QRectF();}
+    void paint(QPainter* _painter, const QStyleOptionGraphicsItem*, QWidget*)
+    {
+        if(store != 0)
+            store->paint(_painter);
+    }
+
+    ProjectileStore* store;
+};
+
+ProjectileStore::ProjectileStore()
+    :layer(0)
+{
+}
+
+ProjectileStore::~ProjectileStore()
+{
+    //The projectiles and the layer can outlive the store when the scene is torn down after it
+    for(auto it = items.begin(); it != items.end(); ++it)
+        (*it)->store = 0;
+    if(layer != 0)
+        layer->store = 0;
+}
+
+QGraphicsItem* ProjectileStore::createLayer()
+{
+    if(layer == 0)
+        layer = new ProjectileLayer(this);
+    return layer;
+}
+
+void ProjectileStore::insert(Projectile* _projectile)
+{
+    if(_projectile->store != 0)
+        return;
+
+    QPointF l_velocity = _projectile->velocity();
+
+    _projectile->store = this;
+    _projectile->storeSlot = items.size();
+
+    items.append(_projectile);
+    xs.append(_projectile->pos().x());
+    ys.append(_projectile->pos().y());
+    vxs.append(l_velocity.x());
+    vys.append(l_velocity.y());
+    //Same size as GameEngine::isOutsideScene() takes, none without a pixmap
+    widths.append(_projectile->isPixmap() ? _projectile->sizePixmap().width() : 0);
+    heights.append(_projectile->isPixmap() ? _projectile->sizePixmap().height() : 0);
+    owners.append(_projectile->getFrom());
+    sprites.append(0);
+    spriteOffsets.append(QPointF());
+    culled.append(0);
+
+    loadSprite(items.size()-1);
+}
+
+void ProjectileStore::remove(Projectile* _projectile)
+{
+    if(_projectile->store != this)
+        return;
+
+    //The last projectile takes the free slot, the arrays stay packed
+    int l_slot = _projectile->storeSlot;
+    int l_last = items.size()-1;
+
+    if(l_slot != l_last)
+    {
+        items[l_slot] = items[l_last];
+        xs[l_slot] = xs[l_last];
+        ys[l_slot] = ys[l_last];
+        vxs[l_slot] = vxs[l_last];
+        vys[l_slot] = vys[l_last];
+        widths[l_slot] = widths[l_last];
+        heights[l_slot] = heights[l_last];
+        owners[l_slot] = owners[l_last];
+        sprites[l_slot] = sprites[l_last];
+        spriteOffsets[l_slot] = spriteOffsets[l_last];
+        culled[l_slot] = culled[l_last];
+        items[l_slot]->storeSlot = l_slot;
+    }
+
+    items.removeLast();
+    xs.removeLast();
+    ys.removeLast();
+    vxs.removeLast();
+    vys.removeLast();
+    widths.removeLast();
+    heights.removeLast();
+    owners.removeLast();
+    sprites.removeLast();
+    spriteOffsets.removeLast();
+    culled.removeLast();
+
+    _projectile->store = 0;
+    _projectile->storeSlot = -1;
+}
+
+void ProjectileStore::update(Projectile* _projectile)
+{
+    if(!_projectile->hasLinearMotion())
+    {
+        if(_projectile->store != this)
+            return;
+
+        //Back to the scene, which moves and draws it again
+        remove(_projectile);
+        if(layer != 0 && layer->scene() != 0)
+            layer->scene()->addItem(_projectile);
+    }
+    else if(_projectile->store != this)
+    {
+        if(_projectile->scene() != 0)
+            _projectile->scene()->removeItem(_projectile);
+        insert(_projectile);
+    }
+    else
+    {
+        QPointF l_velocity = _projectile->velocity();
+        vxs[_projectile->storeSlot] = l_velocity.x();
+        vys[_projectile->storeSlot] = l_velocity.y();
+        loadSprite(_projectile->storeSlot);
+    }
+}
+
+void ProjectileStore::loadSprite(int _slot)
+{
+    const Projectile* l_projectile = items[_slot];
+    if(l_projectile->image == 0)
+    {
+        sprites[_slot] = 0;
+        return;
+    }
+
+    QPointF l_offset;
+    sprites[_slot] = &l_projectile->spriteBlit(*l_projectile->image, l_offset);
+    spriteOffsets[_slot] = l_offset;
+}
+
+void ProjectileStore::advance()
+{
+    int l_n = items.size();
+    qreal* l_x = xs.data();
+    qreal* l_y = ys.data();
+    const qreal* l_vx = vxs.constData();
+    const qreal* l_vy = vys.constData();
+
+    int i = 0;
+#ifdef PROJECTILE_STORE_SSE2
+    for(; i+2 <= l_n; i += 2)
+    {
+        _mm_storeu_pd(l_x+i, _mm_add_pd(_mm_loadu_pd(l_x+i), _mm_loadu_pd(l_vx+i)));
+        _mm_storeu_pd(l_y+i, _mm_add_pd(_mm_loadu_pd(l_y+i), _mm_loadu_pd(l_vy+i)));
+    }
+#endif
+    for(; i<l_n; i++)
+    {
+        l_x[i] += l_vx[i];
+        l_y[i] += l_vy[i];
+    }
+
+    //Outside of a scene, setPos() only stores the position for the collisions
+    for(i = 0;i<l_n;i++)
+        items[i]->setPos(l_x[i], l_y[i]);
+
+    if(layer != 0)
+        layer->update();
+}
+
+void ProjectileStore::paint(QPainter* _painter) const
+{
+    int l_n = items.size();
+    for(int i = 0;i<l_n;i++)
+        if(sprites[i] != 0)
+            _painter->drawPixmap(QPointF(xs[i], ys[i])+spriteOffsets[i], *sprites[i]);
+}
+
+void ProjectileStore::cull(qreal _width, qreal _height, qreal _offset)
+{
+    int l_n = items.size();
+    const qreal* l_x = xs.constData();
+    const qreal* l_y = ys.constData();
+    const qreal* l_w = widths.constData();
+    const qreal* l_h = heights.constData();
+    uchar* l_culled = culled.data();
+
+    //Same test as GameEngine::checkOutsideScene(), in the same order to get the same rounding
+    int i = 0;
+#ifdef PROJECTILE_STORE_SSE2
+    const __m128d l_zero = _mm_setzero_pd();
+    const __m128d l_maxX = _mm_set1_pd(_width);
+    const __m128d l_maxY = _mm_set1_pd(_height);
+    const __m128d l_offset = _mm_set1_pd(_offset);
+
+    for(; i+2 <= l_n; i += 2)
+    {
+        __m128d l_vx = _mm_loadu_pd(l_x+i);
+        __m128d l_vy = _mm_loadu_pd(l_y+i);
+        __m128d l_vw = _mm_loadu_pd(l_w+i);
+
+        __m128d l_out = _mm_or_pd(_mm_cmpgt_pd(_mm_sub_pd(l_vx, l_vw), l_maxX),
+                                  _mm_cmplt_pd(_mm_add_pd(l_vx, l_vw), l_zero));
+        l_out = _mm_or_pd(l_out, _mm_cmpgt_pd(l_vy, l_maxY));
+        l_out = _mm_or_pd(l_out, _mm_cmplt_pd(_mm_add_pd(_mm_add_pd(l_vy, l_offset), _mm_loadu_pd(l_h+i)), l_zero));
+
+        int l_mask = _mm_movemask_pd(l_out);
+        l_culled[i] = l_mask & 1;
+        l_culled[i+1] = (l_mask >> 1) & 1;
+    }
+#endif
+    for(; i<l_n; i++)
+        l_culled[i] = l_x[i]-l_w[i] > _width || l_x[i]+l_w[i] < 0
+                || l_y[i] > _height || l_y[i]+_offset+l_h[i] < 0;
+}
+
+bool ProjectileStore::isCulled(const Projectile* _projectile) const
+{
+    return culled[_projectile->storeSlot] != 0;
+}
+
+bool ProjectileStore::contains(const Projectile* _projectile) const
+{
+    return _projectile->store == this;
+}
@@ -32,6 +32,10 @@ ProjectileV::ProjectileV(qreal _dXOrigin, qreal _dYOrigin, Shooter _from, qreal
     dPower = POWER_V;
     dSpeed = SPEED_V_DEF;
 
+    //x walks by a constant step, so the phase omega*(x-x0) does too
+    stepX = dSpeed*cos(dAngle);
+    phase.reset(0.0, dOmega*stepX);
+
     loadPixmap();
 
 }
@@ -45,18 +49,18 @@ void ProjectileV::advance(int _step)
         Projectile::advance(_step);
     else
     {
-        resetTransform();
-        qreal x = dSpeed*cos(dAngle);
-        qreal y = -(dAmplitude*cos(dOmega*(pos().x()-dXOrigin)));
+        qreal x = stepX;
+        qreal y = -(dAmplitude*phase.cosine());
+        phase.next();
 
         if(from == Player1 && pos().x()-dXOrigin > dOmega*(1.75*M_PI*180.0/M_PI-dXOrigin)*180.0/M_PI
                 || from == Player2 && abs(pos().x()-dXOrigin) > abs(dOmega*(9.25*M_PI*180.0/M_PI-dXOrigin))*180.0/M_PI)
         {
             moveBy(x,0);
             if(from == Player1)
-                setRotation(-2*dAngle*180.0/M_PI);
+                setSpriteRotation(-2*dAngle*180.0/M_PI);
             else
-                setRotation(180.0);
+                setSpriteRotation(180.0);
         }
         else
             if(from == Player1 && dAngle2 < 0 || from == Player2 && dAngle2 > 0)
@@ -69,11 +73,11 @@ void ProjectileV::advance(int _step)
 
 
         if(from == Player1)
-            setTransform(QTransform().translate(x,y).rotateRadians(dAngle2).translate(-x,-y));
+            setSpriteTransform(QTransform().translate(x,y).rotateRadians(dAngle2).translate(-x,-y));
         else
         {
             x -= dXOrigin;
-            setTransform(QTransform().translate(-x,-y).rotateRadians(-dAngle2).translate(x,y));
+            setSpriteTransform(QTransform().translate(-x,-y).rotateRadians(-dAngle2).translate(x,y));
         }
     }
 }
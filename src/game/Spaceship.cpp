@@ -23,8 +23,7 @@
 #include "include/engine/UserControlsEngine.h"
 #include "include/engine/wiimoteengine.h"
 #include "include/game/Spaceship.h"
-#include "include/game/ProjectileCross.h"
-#include "include/game/ProjectileSimple.h"
+#include "include/game/LinearProjectile.h"
 #include "include/game/ProjectileV.h"
 #include "include/game/BonusForceField.h"
 #include "include/game/BonusHP.h"
@@ -40,12 +39,14 @@
 #include "include/game/SpecialBonusFreeze.h"
 #include "include/game/ProjectileGuided.h"
 #include "include/config/Define.h"
+#include "include/utils/SpriteCache.h"
 
 // Temporary constant TO_REMOVE
 #define dSpeed 8
 
 Spaceship::Spaceship(qreal _dX, qreal _dY, Shooter _player, const QString& _playerName, qreal _dHealthPoint, qreal _dResistance, int _cooldown, TypeSpecialBonus _sp, GameEngine *_gameEngine)
-    :Destroyable(_dHealthPoint,_dResistance),
+    :QObject(),
+      Destroyable(_dHealthPoint,_dResistance),
       Displayable(_dX,_dY),
       gameEngine(_gameEngine),//GameEngine
       player(_player),//Kind of player (Player1 or Player2)
@@ -62,7 +63,7 @@ Spaceship::Spaceship(qreal _dX, qreal _dY, Shooter _player, const QString& _play
       specialBonus(0),
       isGuided(false),
       projectileGuided(0),
-      shield(PICTURE_SHIELD)
+      shield(SpriteCache::pixmap(PICTURE_SHIELD))
 {
 
     switch(_sp)
@@ -95,13 +96,13 @@ Spaceship::Spaceship(qreal _dX, qreal _dY, Shooter _player, const QString& _play
     hud->setSpecialBonus(player, specialBonus);
 }
 
-void Spaceship::setPixmap(QPixmap *_pxmPixmap)
+void Spaceship::setPixmap(const QPixmap *_pxmPixmap)
 {
     Displayable::setPixmap(_pxmPixmap);
     if(player == Player2)
     {
         //Rotate the picture for the player2
-        Displayable::setPixmap(new QPixmap(getPixmap()->transformed(QTransform().rotate(180))));
+        Displayable::setPixmap(&SpriteCache::rotated(*getPixmap(), 180.0));
         setPos(pos().x()-getPixmap()->size().width(),pos().y());
     }
 }
@@ -122,21 +123,19 @@ void Spaceship::setY(int _y)
 
 QRectF Spaceship::boundingRect() const
 {
-    return QRectF(getPixmap()->rect());
+    return spriteTransform().mapRect(QRectF(getPixmap()->rect()));
 }
 
 QPainterPath Spaceship::shape() const
 {
-    QPainterPath l_path;
-    l_path.addEllipse(boundingRect());
-    return l_path;
+    return spriteEllipseShape(QRectF(getPixmap()->rect()));
 }
 
 void Spaceship::shotGuidedBonus()
 {
     if(!isGuided)
     {
-        projectileGuided = new ProjectileGuided(getXPositionFire(), getYPositionCenter(), player, this);
+        projectileGuided = new (gameEngine->matchArena()) ProjectileGuided(getXPositionFire(), getYPositionCenter(), player, this);
         gameEngine->addProjectile(projectileGuided);
         isGuided = true;
     }
@@ -154,13 +153,13 @@ void Spaceship::disableGuideBonus()
 
 void Spaceship::paint(QPainter *_painter,const QStyleOptionGraphicsItem *, QWidget *)
 {
-    _painter->drawPixmap(0 , 0, *getPixmap());
+    drawSprite(_painter, *getPixmap());
     if(isInvicible)
     {
-        int l_x = shield.width()/2-getPixmap()->width()/2.0;
-        int l_y = shield.height()/2-getPixmap()->height()/2.0;
+        //The shield is round, it only follows the center of the spaceship
+        QPointF l_center = spriteTransform().map(QPointF(getPixmap()->width()/2.0, getPixmap()->height()/2.0));
 
-        _painter->drawPixmap(-l_x, -l_y, shield);
+        _painter->drawPixmap((l_center-QPointF(shield.width()/2, shield.height()/2)).toPoint(), shield);
     }
 }
 
@@ -176,12 +175,14 @@ void Spaceship::addBonus(Bonus *_bonus)
         bonus = _bonus;
         hud->setNormalBonus(player, bonus);
     }
+    else
+        delete _bonus;//Already out of the scene and of the lists, nobody else would destroy it
 }
 
 void Spaceship::shotTrackingBonus()
 {
     gameEngine->soundEngine()->playSound(ShootSound);
-    gameEngine->addProjectile(new ProjectileTracking(getXPositionFire(), getYPositionFire(), player,(player == Player1) ? gameEngine->ship2() : gameEngine->ship1(),gameEngine));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileTracking(getXPositionFire(), getYPositionFire(), player,(player == Player1) ? gameEngine->ship2() : gameEngine->ship1(),gameEngine));
 }
 
 void Spaceship::shotMultiBonus()
@@ -191,16 +192,16 @@ void Spaceship::shotMultiBonus()
     qreal l_y = getYPositionFire();
     qreal angle = dAngleAttack*M_PI/180.0;
 
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,1,0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,-1,0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,0.25,1.0/2.0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,0.6,1.0/3.0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,0.8,1.0/4.0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,0.8,1.0/5.0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,-0.25,1.0/2.0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,-0.6,1.0/3.0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,-0.8,1.0/4.0,angle));
-    gameEngine->addProjectile(new ProjectileMulti(l_x,l_y,player,-0.8,1.0/5.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,1,0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,-1,0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,0.25,1.0/2.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,0.6,1.0/3.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,0.8,1.0/4.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,0.8,1.0/5.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,-0.25,1.0/2.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,-0.6,1.0/3.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,-0.8,1.0/4.0,angle));
+    gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileMulti(l_x,l_y,player,-0.8,1.0/5.0,angle));
 }
 
 void Spaceship::triggerBonus()
@@ -280,7 +281,6 @@ void Spaceship::receiveAttack(qreal _dPower)
 
 void Spaceship::rotate(qreal pitch)
 {
-    resetTransform();
     qreal x = getPixmap()->width()/2.0;
     qreal y = getPixmap()->height()/2.0;
     qreal angle = -pitch;
@@ -288,7 +288,7 @@ void Spaceship::rotate(qreal pitch)
     if(player == Player2)
         angle *= -1;
 
-    setTransform(QTransform().translate(x,y).rotate(angle).translate(-x,-y));
+    setSpriteTransform(QTransform().translate(x,y).rotate(angle).translate(-x,-y));
     dAngleAttack = angle;
 }
 
@@ -311,16 +311,17 @@ void Spaceship::attack()
     switch(type)
     {
         case ProjSimple:
-            gameEngine->addProjectile(new ProjectileSimple(l_x,l_y,player,angle));
+            gameEngine->addProjectile(new (gameEngine->matchArena()) LinearProjectile(SimpleKind,l_x,l_y,player,angle));
             break;
 
         case ProjCross:
+            //Tilted by -1, 0 and 1 SLOPE_CROSS to draw the cross
             for(int i = 0;i<3;i++)
-                gameEngine->addProjectile(new ProjectileCross(l_x,l_y,player,i-1,angle));
+                gameEngine->addProjectile(new (gameEngine->matchArena()) LinearProjectile(CrossKind,l_x,l_y,player,angle-(i-1)*(SLOPE_CROSS)));
             break;
 
         case ProjV:
-            gameEngine->addProjectile(new ProjectileV(l_x,l_y,player,AMPLI_SPACESHIP_PROJ_V,OMEGA_SPACESHIP_PROJ_V,angle));
+            gameEngine->addProjectile(new (gameEngine->matchArena()) ProjectileV(l_x,l_y,player,AMPLI_SPACESHIP_PROJ_V,OMEGA_SPACESHIP_PROJ_V,angle));
             break;
         case ProjAlien:
             break;
@@ -0,0 +1,55 @@
+#include "include/game/SpawnQueue.h"
+#include "include/game/Displayable.h"
+
+SpawnQueue::SpawnQueue()
+    :head(0),tick(0)
+{
+}
+
+void SpawnQueue::push(Displayable* _item, Target _target)
+{
+    Pending l_pending;
+    l_pending.item = _item;
+    l_pending.target = _target;
+    l_pending.tick = tick;
+    pending.append(l_pending);
+}
+
+void SpawnQueue::push(const Factory& _create, Target _target)
+{
+    Pending l_pending;
+    l_pending.item = 0;
+    l_pending.create = _create;
+    l_pending.target = _target;
+    l_pending.tick = tick;
+    pending.append(l_pending);
+}
+
+void SpawnQueue::endTick(int _nbSpawned, qint64 _cost)
+{
+    if(_nbSpawned > 0)
+        cost.addSample(_cost);
+
+    //The queue is empty most of the time, the front is only dropped when it has grown
+    if(isEmpty())
+    {
+        pending.clear();
+        head = 0;
+    }
+    else if(head > pending.size()/2)
+    {
+        pending.remove(0, head);
+        head = 0;
+    }
+
+    tick++;
+}
+
+void SpawnQueue::discardAll()
+{
+    for(int i = head;i<pending.size();i++)
+        delete pending[i].item;
+
+    pending.clear();
+    head = 0;
+}
@@ -29,12 +29,28 @@ Supernova::Supernova(qreal _dX, qreal _dY,GameEngine *_gameEngine):
 {
 }
 
-Supernova::~Supernova()
+void Supernova::explode()
 {
-    gameEngine->displayEngine()->explosionScreen();
-
-    gameEngine->soundEngine()->playSound(SupernovaSound);
+    //The whole burst goes through the spawn queue and its budget : the flash and the sound
+    //come with the first asteroid, each asteroid is built when it enters the game.
+    //The supernova is deleted after this call, the functions only keep copies
+    GameEngine* l_gameEngine = gameEngine;
+    qreal l_dX = dX;
+    qreal l_dY = dY;
 
     for(int i = 0;i<nbSpirales;i++)
-        gameEngine->addAsteroid(new AsteroidSupernova(dX,dY,Other,SUPERNOVA_RESISTANCE,MAX_SPACESHIP_PV/2.0,gameEngine,static_cast<double>(2*M_PI)/nbSpirales*(i+1)));
+    {
+        bool l_first = i == 0;
+        qreal l_angle = static_cast<double>(2*M_PI)/nbSpirales*(i+1);
+
+        gameEngine->spawnLater([=]() -> Displayable*
+        {
+            if(l_first)
+            {
+                l_gameEngine->displayEngine()->explosionScreen();
+                l_gameEngine->soundEngine()->playSound(SupernovaSound);
+            }
+            return new (l_gameEngine->matchArena()) AsteroidSupernova(l_dX,l_dY,Other,SUPERNOVA_RESISTANCE,MAX_SPACESHIP_PV/2.0,l_gameEngine,l_angle);
+        }, SpawnQueue::ToAsteroids);
+    }
 }
@@ -0,0 +1,36 @@
+#include "include/kinect/HandFilter.h"
+
+#include <qmath.h>
+
+HandFilter::HandFilter()
+	:initialised(false)
+{
+}
+
+qreal HandFilter::smoothing(qreal _cutoff, qreal _dt)
+{
+	qreal tau = 1.0 / (2.0 * M_PI * _cutoff);
+	return 1.0 / (1.0 + tau / _dt);
+}
+
+QPointF HandFilter::filter(const QPointF& _position, qreal _dt)
+{
+	if(!initialised || _dt <= 0.0)
+	{
+		if(!initialised)
+		{
+			position = _position;
+			speed = QPointF(0, 0);
+			initialised = true;
+		}
+		return position + speed * parameters.prediction;
+	}
+
+	QPointF rawSpeed = (_position - position) / _dt;
+	speed += (rawSpeed - speed) * smoothing(parameters.derivativeCutoff, _dt);
+
+	qreal velocity = qSqrt(speed.x() * speed.x() + speed.y() * speed.y());
+	position += (_position - position) * smoothing(parameters.minCutoff + parameters.beta * velocity, _dt);
+
+	return position + speed * parameters.prediction;
+}
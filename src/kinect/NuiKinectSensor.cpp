@@ -0,0 +1,219 @@
+#include "include/kinect/NuiKinectSensor.h"
+
+#include <algorithm>
+
+static_assert(sizeof(JointPosition) == sizeof(Vector4), "JointPosition must have the layout of Vector4");
+static_assert(SkeletonFrame::kSkeletonCount == NUI_SKELETON_COUNT, "one slot per skeleton of the SDK");
+static_assert(SkeletonFrame::kJointCount == NUI_SKELETON_POSITION_COUNT, "one slot per joint of the SDK");
+
+NuiKinectSensor::NuiKinectSensor() :
+	m_kinect(nullptr),
+	m_pColorStreamHandle(INVALID_HANDLE_VALUE),
+	m_hNextColorFrameEvent(INVALID_HANDLE_VALUE),
+	m_hNextSkeletonEvent(INVALID_HANDLE_VALUE)
+{
+}
+
+NuiKinectSensor::~NuiKinectSensor()
+{
+	close();
+}
+
+bool NuiKinectSensor::isAvailable() const
+{
+	return sensorCount() > 0;
+}
+
+int NuiKinectSensor::sensorCount() const
+{
+	int numSensors = 0;
+	return NuiGetSensorCount(&numSensors) == S_OK ? numSensors : 0;
+}
+
+/**
+* Initialize the kinect device and all the stream.
+*/
+bool NuiKinectSensor::open(QString& _report)
+{
+	if (!isAvailable()) { _report = "no kinect available"; return false; }
+	if (m_kinect == nullptr && NuiCreateSensorByIndex(0, &m_kinect) < 0) { _report = "fail to create the kinect"; return false; }
+
+	// initialize the kinect for skeletion and color, it's possible to add more than only the skeletion (e.g. camera)
+	HRESULT hr = m_kinect->NuiInitialize(NUI_INITIALIZE_FLAG_USES_COLOR | NUI_INITIALIZE_FLAG_USES_SKELETON);
+	if (FAILED(hr)) { _report = "fail to open initialize kinect"; return false; }
+
+	// Create an event that will be signaled when skeleton data is available
+	m_hNextSkeletonEvent = CreateEventW(0, TRUE, FALSE, 0);
+
+	// Open a skeleton stream to receive skeleton data
+	hr = m_kinect->NuiSkeletonTrackingEnable(m_hNextSkeletonEvent, 0); //NUI_SKELETON_TRACKING_FLAG_ENABLE_IN_NEAR_RANGE);
+	if (FAILED(hr))
+		_report = "fail to open a skeleton stream";
+
+	// Create an event that will be signaled when color data is available
+	m_hNextColorFrameEvent = CreateEventW(0, TRUE, FALSE, 0);
+
+	hr = m_kinect->NuiImageStreamOpen(
+		NUI_IMAGE_TYPE_COLOR,            // Depth camera or rgb camera?
+		NUI_IMAGE_RESOLUTION_1280x960,    // Image resolution
+		0,      // Image stream flags, e.g. near mode
+		2,      // Number of frames to buffer
+		m_hNextColorFrameEvent,   // Event handle
+		&m_pColorStreamHandle);
+
+	if (FAILED(hr))
+		_report += " fail to open a color stream";
+	else
+		_report += " A color stream is open";
+
+	return true;
+}
+
+void NuiKinectSensor::close()
+{
+	if (m_kinect)
+	{
+		m_kinect->NuiShutdown(); //Shutdown the kinect
+		m_kinect->Release();
+		m_kinect = nullptr;
+	}
+
+	closeColor();
+	if (m_hNextSkeletonEvent != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_hNextSkeletonEvent);
+		m_hNextSkeletonEvent = INVALID_HANDLE_VALUE;
+	}
+}
+
+bool NuiKinectSensor::isWorking() const
+{
+	return m_kinect != nullptr && m_kinect->NuiStatus() == S_OK;
+}
+
+QString NuiKinectSensor::statusDescription() const
+{
+	if (m_kinect == nullptr)
+		return "The device is not created.";
+
+	switch (m_kinect->NuiStatus())
+	{
+	case S_OK:							return "The device is connected and work.";
+	case S_NUI_INITIALIZING:			return "The device is connected, but still initializing.";
+	case E_NUI_NOTCONNECTED:			return "The device is not connected.";
+	case E_NUI_NOTGENUINE:				return "The device is not a valid Kinect.";
+	case E_NUI_NOTSUPPORTED:			return "The device is an unsupported model.";
+	case E_NUI_INSUFFICIENTBANDWIDTH:	return "The device is connected to a hub without the necessary bandwidth requirements.";
+	case E_NUI_NOTPOWERED:				return "The device is connected, but unpowered.";
+	case E_NUI_NOTREADY:				return "There was some other unspecified error.";
+	default:							return "Unknown status.";
+	}
+}
+
+void NuiKinectSensor::setElevationAngle(int _angle)
+{
+	if (m_kinect)
+		m_kinect->NuiCameraElevationSetAngle(_angle);
+}
+
+int NuiKinectSensor::waitForFrames(int _timeout)
+{
+	HANDLE events[2];
+	int streams[2];
+	DWORD nbEvents = 0;
+
+	if (m_hNextSkeletonEvent != INVALID_HANDLE_VALUE) { events[nbEvents] = m_hNextSkeletonEvent; streams[nbEvents++] = SkeletonStream; }
+	if (m_hNextColorFrameEvent != INVALID_HANDLE_VALUE) { events[nbEvents] = m_hNextColorFrameEvent; streams[nbEvents++] = ColorStream; }
+
+	if (nbEvents == 0 || WaitForMultipleObjects(nbEvents, events, FALSE, _timeout) == WAIT_TIMEOUT)
+		return NoStream;
+
+	// Both streams may be ready, the events are manual reset and stay signaled until their frame is read
+	int ready = NoStream;
+	for (DWORD i = 0; i < nbEvents; ++i)
+		if (WaitForSingleObject(events[i], 0) == WAIT_OBJECT_0)
+			ready |= streams[i];
+	return ready;
+}
+
+/**
+* Fetch the data of the skeletons in front of the kinect
+*/
+bool NuiKinectSensor::readSkeletons(SkeletonFrame& _frame)
+{
+	NUI_SKELETON_FRAME skeletonFrame = {0};
+
+	HRESULT hr = m_kinect->NuiSkeletonGetNextFrame(0, &skeletonFrame); // get the new skeleton infos
+	if (FAILED(hr)) return false;
+
+	// No NuiTransformSmooth, its lag adds to the one of the sensor : QKinect filters the hands it uses
+	_frame.timestamp = skeletonFrame.liTimeStamp.QuadPart;
+	for (int i = 0 ; i < NUI_SKELETON_COUNT; ++i)
+	{
+		const Vector4* positions = skeletonFrame.SkeletonData[i].SkeletonPositions;
+		_frame.states[i] = static_cast<SkeletonState>(skeletonFrame.SkeletonData[i].eTrackingState);
+		std::copy(reinterpret_cast<const JointPosition*>(positions), reinterpret_cast<const JointPosition*>(positions) + NUI_SKELETON_POSITION_COUNT, _frame.joints[i].begin());
+	}
+	return true;
+}
+
+/**
+* Fetch the data of the color camera stream
+*/
+const uchar* NuiKinectSensor::lockColor(unsigned long& _size)
+{
+	// Attempt to get the color frame
+	HRESULT hr = m_kinect->NuiImageStreamGetNextFrame(m_pColorStreamHandle, 0, &m_colorFrame);
+	if (FAILED(hr)) return nullptr;
+
+	// Lock the frame data so the Kinect knows not to modify it while we're reading it
+	NUI_LOCKED_RECT lockedRect;
+	m_colorFrame.pFrameTexture->LockRect(0, &lockedRect, 0, 0);
+
+	// Make sure we've received valid data
+	if (lockedRect.Pitch == 0)
+	{
+		unlockColor();
+		return nullptr;
+	}
+
+	_size = lockedRect.size;
+	return static_cast<const uchar*>(lockedRect.pBits);
+}
+
+void NuiKinectSensor::unlockColor()
+{
+	// We're done with the texture so unlock it
+	m_colorFrame.pFrameTexture->UnlockRect(0);
+
+	// Release the frame
+	m_kinect->NuiImageStreamReleaseFrame(m_pColorStreamHandle, &m_colorFrame);
+}
+
+void NuiKinectSensor::closeColor()
+{
+	if (m_hNextColorFrameEvent == INVALID_HANDLE_VALUE)
+		return;
+
+	CloseHandle(m_hNextColorFrameEvent); // close the color stream
+	m_hNextColorFrameEvent = INVALID_HANDLE_VALUE;
+	m_pColorStreamHandle = INVALID_HANDLE_VALUE;
+
+	// The SDK can't close a single stream, the sensor is initialized again with the skeleton only.
+	// Otherwise the 1280x960 color stream keeps its USB bandwidth and its conversion for the whole session
+	if (m_kinect)
+	{
+		m_kinect->NuiShutdown();
+		if (SUCCEEDED(m_kinect->NuiInitialize(NUI_INITIALIZE_FLAG_USES_SKELETON)))
+			m_kinect->NuiSkeletonTrackingEnable(m_hNextSkeletonEvent, 0);
+	}
+}
+
+cv::Point2f NuiKinectSensor::toDepthImage(const JointPosition& _joint) const
+{
+	// NuiTransformSkeletonToDepthImage returns coordinates in NUI_IMAGE_RESOLUTION_320x240 space
+	Vector4 position = {_joint.x, _joint.y, _joint.z, _joint.w};
+	FLOAT x, y;
+	NuiTransformSkeletonToDepthImage(position, &x, &y);
+	return cv::Point2f(x, y);
+}
@@ -0,0 +1,162 @@
+#include "include/kinect/RecordedKinectSensor.h"
+
+#include <QFileInfo>
+#include <QThread>
+#include <cstring>
+
+using namespace SkeletonRecordingFormat;
+
+namespace
+{
+	// Same projection as NuiTransformSkeletonToDepthImage at 320x240
+	const float kDepthWidth = 320.0f;
+	const float kDepthHeight = 240.0f;
+	const float kDepthFocalLength = 285.63f;
+}
+
+RecordedKinectSensor::RecordedKinectSensor(const QString& _path, qreal _speed)
+	:path(_path),speed(_speed),startArrival(0),cursor(0),firstColor(-1),lastColor(-1),colorOpen(false),nextColor(0)
+{
+}
+
+bool RecordedKinectSensor::isAvailable() const
+{
+	return QFileInfo(path).isFile();
+}
+
+int RecordedKinectSensor::sensorCount() const
+{
+	return isAvailable() ? 1 : 0;
+}
+
+bool RecordedKinectSensor::open(QString& _report)
+{
+	if(!recording.open(path))
+	{
+		_report = QString("fail to open the recording %1").arg(path);
+		return false;
+	}
+
+	// Without color frames there is no camera to play
+	firstColor = -1;
+	for(int i = 0; firstColor < 0 && i < recording.count(); ++i)
+		if(recording.kind(i) == ColorKind)
+			firstColor = i;
+	colorOpen = firstColor >= 0;
+
+	seek(0);
+	_report = QString("%1 frames recorded in %2").arg(recording.count()).arg(path);
+	return true;
+}
+
+void RecordedKinectSensor::close()
+{
+	recording.close();
+	colorOpen = false;
+}
+
+bool RecordedKinectSensor::isWorking() const
+{
+	return recording.isOpen();
+}
+
+QString RecordedKinectSensor::statusDescription() const
+{
+	if(!recording.isOpen())
+		return "The recording is not open.";
+	return QString("Playing the recording, frame %1 of %2.").arg(cursor).arg(recording.count());
+}
+
+void RecordedKinectSensor::seek(qint64 _arrival)
+{
+	cursor = recording.find(_arrival);
+
+	// The color frame shown at that time is the last one before it
+	lastColor = -1;
+	for(int i = 0; i < cursor; ++i)
+		if(recording.kind(i) == ColorKind)
+			lastColor = i;
+
+	startArrival = cursor < recording.count() ? recording.arrival(cursor) : 0;
+	cursor = nextSkeleton(cursor);
+	clock.start();
+	nextColor = 0;
+}
+
+int RecordedKinectSensor::nextSkeleton(int _from) const
+{
+	int i = _from;
+	for(; i < recording.count() && recording.kind(i) != SkeletonKind; ++i)
+		;
+	return i;
+}
+
+qint64 RecordedKinectSensor::dueTime(int _frame) const
+{
+	if(speed <= 0)
+		return 0;
+	return static_cast<qint64>((recording.arrival(_frame)-startArrival)/speed);
+}
+
+int RecordedKinectSensor::waitForFrames(int _timeout)
+{
+	qint64 now = clock.nsecsElapsed()/1000;
+	qint64 limit = now+_timeout*1000;
+
+	qint64 wakeUp = limit;
+	if(cursor < recording.count())
+		wakeUp = qMin(wakeUp, dueTime(cursor));
+	if(colorOpen)
+		wakeUp = qMin(wakeUp, nextColor*1000);
+
+	if(wakeUp > now)
+	{
+		QThread::usleep(static_cast<unsigned long>(wakeUp-now));
+		now = clock.nsecsElapsed()/1000;
+	}
+
+	int ready = NoStream;
+	if(cursor < recording.count() && dueTime(cursor) <= now)
+		ready |= SkeletonStream;
+	if(colorOpen && nextColor*1000 <= now)
+		ready |= ColorStream;
+	return ready;
+}
+
+bool RecordedKinectSensor::readSkeletons(SkeletonFrame& _frame)
+{
+	if(cursor >= recording.count())
+		return false;
+
+	memcpy(&_frame, recording.payload(cursor), sizeof(SkeletonFrame));
+
+	// The color frames passed on the way become the picture of the camera
+	int next = cursor+1;
+	for(; next < recording.count() && recording.kind(next) != SkeletonKind; ++next)
+		if(recording.kind(next) == ColorKind)
+			lastColor = next;
+	cursor = next;
+	return true;
+}
+
+const uchar* RecordedKinectSensor::lockColor(unsigned long& _size)
+{
+	nextColor = clock.elapsed()+kColorPeriod;
+
+	// Before the first color frame of the recording is reached, the camera shows it anyway
+	int frame = lastColor >= 0 ? lastColor : firstColor;
+	if(frame < 0)
+		return nullptr;
+
+	_size = recording.size(frame);
+	return recording.payload(frame);
+}
+
+cv::Point2f RecordedKinectSensor::toDepthImage(const JointPosition& _joint) const
+{
+	if(_joint.z <= 1e-7f)
+		return cv::Point2f(0, 0);
+
+	return cv::Point2f(kDepthWidth/2 + _joint.x * kDepthFocalLength / _joint.z,
+	                   kDepthHeight/2 - _joint.y * kDepthFocalLength / _joint.z);
+}
@@ -10,130 +10,255 @@
 using namespace std;
 using namespace cv;
 
-RectangleDetection::RectangleDetection(int _thresh, int _N):thresh(_thresh),N(_N)
+namespace
 {
+const int threshold_level = 15;
+const double min_area = 1000;// (pixels at full resolution)
+const int pyramid_levels = 2;// the coarse search runs at 1/4 scale
+const int fallback_levels = 1;// then at 1/2 scale when it finds nothing, never at full resolution
 
+// Green channel of the blurred image, shared by every threshold level
+Mat greenChannel(const Mat& image, int blur)
+{
+    // blur will enhance edge detection
+    // (into its own buffer, the image is the frame of the Kinect itself)
+    Mat blurred;
+    medianBlur(image, blurred, blur);
+
+    Mat gray0(blurred.size(), CV_8U);
+    int ch[] = {1, 0};//Green channel
+    mixChannels(&blurred, 1, &gray0, 1, ch, 1);
+    return gray0;
 }
 
-void RectangleDetection::addImage(const Mat& image)
+// Same green channel on a level of the pyramid, the blur shrinks with the image
+Mat coarseGreenChannel(const Mat& image, int levels)
 {
-	if(!image.empty())
-	{
-		images.push_back(Mat(image));
-		points.push_back(vector<vector<Point>>());	
-	}
+    Mat small = image;
+    for(int i = 0; i < levels; ++i)
+    {
+        Mat down;
+        pyrDown(small, down);
+        small = down;
+    }
+    return greenChannel(small, (9 >> levels) | 1);//9 at full resolution, like findSquares
 }
 
-bool sortPoint(const Point& p1, const Point& p2)
+// Brings a square found on a coarse image back to full resolution. Each corner is
+// searched again in a small window around its coarse position, and only that window
+// of the frame is read : its green channel is extracted there and nowhere else
+void refineCorners(const Mat& image, vector<Point>& square, int levels)
 {
-	return abs(p1.x - p2.x) > 50 || abs(p2.y - p2.y) > 50;
+    // Half size of the sub-pixel search, two coarse pixels so the coarse error stays inside.
+    // The patch has twice that margin, cornerSubPix moves its window along the iterations
+    const int window = 2 << levels;
+    const int margin = 2*window + 1;
+    const Rect frame(0, 0, image.cols, image.rows);
+
+    for(size_t i = 0; i < square.size(); ++i)
+    {
+        Point coarse(square[i].x << levels, square[i].y << levels);
+        Rect roi = Rect(coarse.x - margin, coarse.y - margin, 2*margin + 1, 2*margin + 1) & frame;
+        if(roi.area() == 0)
+            continue;
+
+        Mat patch = image(roi);
+        Mat green(roi.size(), CV_8U);
+        int ch[] = {1, 0};//Green channel
+        mixChannels(&patch, 1, &green, 1, ch, 1);
+
+        vector<Point2f> corner(1, Point2f(static_cast<float>(coarse.x - roi.x), static_cast<float>(coarse.y - roi.y)));
+        cornerSubPix(green, corner, Size(window, window), Size(-1,-1),
+                     TermCriteria(CV_TERMCRIT_EPS|CV_TERMCRIT_ITER, 20, 0.1));
+
+        square[i] = Point(cvRound(corner[0].x) + roi.x, cvRound(corner[0].y) + roi.y);
+    }
 }
 
-array<Point, 4> RectangleDetection::getPoints()
+// First square found at the threshold level l, empty if there is none
+bool findSquareAtLevel(const Mat& gray0, int l, vector<Point>& square, double minArea)
 {
-	vector<vector<int>> pointsSort(8);
-	bool isThereMinimumOneSquare = false;
-	for(size_t i = 0;i < images.size(); ++i)
-	{
-		bool squaresfound = findSquares(images[i], points[i], thresh, N);
-		isThereMinimumOneSquare |= squaresfound;
-		if(squaresfound)
-		{
-			findLargestSquare(points[i]);
-			sort(points[i][0].begin(),points[i][0].end(),sortPoint);
+    Mat gray;
+    vector<vector<Point> > contours;
 
-			for(int j = 0; j < 4; ++j)
-			{
-				pointsSort[2*j].push_back(points[i][0][j].x);//x0y0 -> x0
-				pointsSort[2*j+1].push_back(points[i][0][j].y);//x0y0 -> y0
-			}
-		}
-	}
+    // Use Canny instead of zero threshold level!
+    // Canny helps to catch squares with gradient shading
+    if (l == 0)
+    {
+        Canny(gray0, gray, 10, 20, 3); // 
 
-	array<Point, 4> ret;
-	if(isThereMinimumOneSquare)
-	{
-		for(int i = 0; i < 8; ++i)
-			sort(pointsSort[i].begin(),pointsSort[i].end());
+        // Dilate helps to remove potential holes between edge segments
+        dilate(gray, gray, Mat(), Point(-1,-1));
+    }
+    else
+    {
+            gray = gray0 >= (l+1) * 255 / threshold_level;
+    }
 
-		bool even = images.size()-1 % 2 == 0;
-		for(int i = 0; i < 4; ++i)
-			ret[i] = (even) ? Point(pointsSort[2*i][images.size()/2],pointsSort[2*i+1][images.size()/2]) : Point(pointsSort[2*i][images.size()/2+1],pointsSort[2*i+1][images.size()/2+1]);
-	}
-	else
-		for(int i = 0; i < 4; ++i)
-			ret[i] = Point(0,0);
-	return ret;
+    // Find contours and store them in a list
+    findContours(gray, contours, CV_RETR_LIST, CV_CHAIN_APPROX_SIMPLE);
+
+    // Test contours
+    vector<Point> approx;
+    for (size_t i = 0; i < contours.size(); i++)
+    {
+            // approximate contour with accuracy proportional
+            // to the contour perimeter
+            approxPolyDP(Mat(contours[i]), approx, arcLength(Mat(contours[i]), true)*0.02, true);
+
+            // Note: absolute value of an area is used because
+            // area may be positive or negative - in accordance with the
+            // contour orientation
+            if (approx.size() == 4 &&
+                    fabs(contourArea(Mat(approx))) > minArea &&
+                    isContourConvex(Mat(approx)))
+            {
+                    double maxCosine = 0;
+
+                    for (int j = 2; j < 5; j++)
+                    {
+                            double cosine = fabs(angle(approx[j%4], approx[j-2], approx[j-1]));
+                            maxCosine = MAX(maxCosine, cosine);
+                    }
+
+                    if (maxCosine < 0.3)
+						{
+                            square = approx;
+								return true;
+						}
+            }
+    }
+	return false;
 }
 
-bool findSquares(const Mat& image, vector<vector<Point> >& squares, int thresh, int N)
+// One job per threshold level, each writes only its own slot
+class SquareSearchBody : public ParallelLoopBody
 {
-    // blur will enhance edge detection
-    Mat blurred(image);
-    medianBlur(image, blurred, 9);
+public:
+    SquareSearchBody(const Mat& _gray, vector<vector<Point> >& _found, double _minArea)
+        :gray(_gray), found(_found), minArea(_minArea) {}
 
-    Mat gray0(blurred.size(), CV_8U), gray;
-    vector<vector<Point> > contours;
+    void operator()(const Range& range) const
+    {
+        for(int l = range.start; l < range.end; ++l)
+            findSquareAtLevel(gray, l, found[l], minArea);
+    }
 
-    // find green squares
-    int ch[] = {1, 0};//Green channel
-    mixChannels(&blurred, 1, &gray0, 1, ch, 1);
+private:
+    const Mat& gray;
+    vector<vector<Point> >& found;
+    double minArea;
+};
 
-    // try several threshold levels
-    const int threshold_level = 15;
-    for (int l = 0; l < threshold_level; l++)
-    {
-        // Use Canny instead of zero threshold level!
-        // Canny helps to catch squares with gradient shading
-        if (l == 0)
-        {
-            Canny(gray0, gray, 10, 20, 3); // 
+// Threshold levels searched in parallel on the image reduced by 2^levels,
+// the corners of the square found are refined at full resolution
+bool findSquaresAtScale(const Mat& image, vector<vector<Point> >& squares, int levels)
+{
+    Mat gray = coarseGreenChannel(image, levels);
 
-            // Dilate helps to remove potential holes between edge segments
-            dilate(gray, gray, Mat(), Point(-1,-1));
-        }
-        else
+    vector<vector<Point> > found(threshold_level);
+    parallel_for_(Range(0, threshold_level), SquareSearchBody(gray, found, min_area/(1 << 2*levels)));
+
+    // Reduced in the serial order : the lowest level with a square wins,
+    // whatever the order in which the jobs ended
+    for(int l = 0; l < threshold_level; ++l)
+        if(!found[l].empty())
         {
-                gray = gray0 >= (l+1) * 255 / threshold_level;
+            squares.push_back(found[l]);
+            refineCorners(image, squares.back(), levels);
+            return true;
         }
+    return false;
+}
+
+// Median of the values and largest distance of the central half of them to it
+void medianSpread(vector<int> values, int& median, int& spread)
+{
+    size_t middle = values.size()/2;
+    nth_element(values.begin(), values.begin()+middle, values.end());
+    median = values[middle];
+
+    for(size_t i = 0; i < values.size(); ++i)
+        values[i] = abs(values[i]-median);
+    nth_element(values.begin(), values.begin()+middle, values.end());
+    spread = values[middle];
+}
+}
 
-        // Find contours and store them in a list
-        findContours(gray, contours, CV_RETR_LIST, CV_CHAIN_APPROX_SIMPLE);
+bool findSquares(const Mat& image, vector<vector<Point> >& squares, int thresh, int N)
+{
+    Mat gray0 = greenChannel(image, 9);
 
-        // Test contours
-        vector<Point> approx;
-        for (size_t i = 0; i < contours.size(); i++)
+    // try several threshold levels
+    vector<Point> square;
+    for (int l = 0; l < threshold_level; l++)
+        if (findSquareAtLevel(gray0, l, square, min_area))
         {
-                // approximate contour with accuracy proportional
-                // to the contour perimeter
-                approxPolyDP(Mat(contours[i]), approx, arcLength(Mat(contours[i]), true)*0.02, true);
-
-                // Note: absolute value of an area is used because
-                // area may be positive or negative - in accordance with the
-                // contour orientation
-                if (approx.size() == 4 &&
-                        fabs(contourArea(Mat(approx))) > 1000 &&
-                        isContourConvex(Mat(approx)))
-                {
-                        double maxCosine = 0;
-
-                        for (int j = 2; j < 5; j++)
-                        {
-                                double cosine = fabs(angle(approx[j%4], approx[j-2], approx[j-1]));
-                                maxCosine = MAX(maxCosine, cosine);
-                        }
-
-                        if (maxCosine < 0.3)
-						{
-                                squares.push_back(approx);
-								return true;
-						}
-                }
+            squares.push_back(square);
+            return true;
         }
-    }
 	return false;
 }
 
+bool findSquaresPyramid(const Mat& image, vector<vector<Point> >& squares)
+{
+    // The coarse image can miss a thin screen, the half resolution is the last resort.
+    // A frame where both miss is only one image less for the calibration
+    return findSquaresAtScale(image, squares, pyramid_levels)
+        || findSquaresAtScale(image, squares, fallback_levels);
+}
+
+RectangleDetection::RectangleDetection(int _thresh, int _N):nbImages(0),stable(false),thresh(_thresh),N(_N)
+{
+
+}
+
+void RectangleDetection::addImage(const Mat& image)
+{
+	if(image.empty())
+		return;
+
+	//The image is searched right away, nothing of it is kept but the corners
+	nbImages++;
+	vector<vector<Point> > squares;
+	if(findSquaresPyramid(image, squares))
+	{
+		findLargestSquare(squares);
+		//The medians are taken corner by corner, each image must give them in the same order
+		array<Point, 4> corners = orderCorners(squares[0]);
+		for(int j = 0; j < 4; ++j)
+		{
+			coordinates[2*j].push_back(corners[j].x);//x0y0 -> x0
+			coordinates[2*j+1].push_back(corners[j].y);//x0y0 -> y0
+		}
+		updateEstimate();
+	}
+}
+
+void RectangleDetection::updateEstimate()
+{
+	stable = coordinates[0].size() >= kMinSquares;
+	for(int i = 0; i < 8; ++i)
+	{
+		int spread;
+		medianSpread(coordinates[i], median[i], spread);
+		stable &= spread <= kTolerance;
+	}
+}
+
+bool RectangleDetection::isDone() const
+{
+	return stable || nbImages >= kMaxImages;
+}
+
+array<Point, 4> RectangleDetection::getPoints()
+{
+	array<Point, 4> ret;
+	for(int i = 0; i < 4; ++i)
+		ret[i] = (coordinates[0].empty()) ? Point(0,0) : Point(median[2*i],median[2*i+1]);
+	return ret;
+}
+
 void findLargestSquare(std::vector<std::vector<cv::Point> >& squares)
 {
 	if(!squares.empty())
@@ -160,7 +285,6 @@ void findLargestSquare(std::vector<std::vector<cv::Point> >& squares)
 		squares.clear();
 		squares = largestSquares;
 
-		sort(squares[0].begin(),squares[0].end(),sortPoint);
 		cout << "(" << squares[0][0].x << "," << squares[0][0].y << "),"
 		<< "(" << squares[0][1].x << "," << squares[0][1].y << "),"
 		<< "(" << squares[0][2].x << "," << squares[0][2].y << "),"
@@ -168,6 +292,26 @@ void findLargestSquare(std::vector<std::vector<cv::Point> >& squares)
 	}
 }
 
+array<Point, 4> orderCorners(const vector<Point>& square)
+{
+	// Told apart by the sum and the difference of their coordinates
+	int topLeft = 0, topRight = 0, bottomRight = 0, bottomLeft = 0;
+	for(int i = 1; i < 4; ++i)
+	{
+		if(square[i].x+square[i].y < square[topLeft].x+square[topLeft].y) topLeft = i;
+		if(square[i].x+square[i].y > square[bottomRight].x+square[bottomRight].y) bottomRight = i;
+		if(square[i].x-square[i].y > square[topRight].x-square[topRight].y) topRight = i;
+		if(square[i].x-square[i].y < square[bottomLeft].x-square[bottomLeft].y) bottomLeft = i;
+	}
+
+	array<Point, 4> corners;
+	corners[0] = square[topLeft];
+	corners[1] = square[topRight];
+	corners[2] = square[bottomRight];
+	corners[3] = square[bottomLeft];
+	return corners;
+}
+
 // helper function:
 // finds a cosine of angle between vectors
 // from pt0->pt1 and from pt0->pt2
@@ -178,4 +322,4 @@ double angle(Point pt1, Point pt2, Point pt0 )
     double dx2 = pt2.x - pt0.x;
     double dy2 = pt2.y - pt0.y;
     return (dx1*dx2 + dy1*dy2)/sqrt((dx1*dx1 + dy1*dy1)*(dx2*dx2 + dy2*dy2) + 1e-10);
-}
\ No newline at end of file
+}
\ No newline at end of file
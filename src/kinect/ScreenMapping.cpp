@@ -0,0 +1,56 @@
+#include "include/kinect/ScreenMapping.h"
+
+#include "opencv2/imgproc/imgproc.hpp"
+
+using namespace std;
+using namespace cv;
+
+ScreenMapping::ScreenMapping()
+{
+
+}
+
+void ScreenMapping::calibrate(const array<Point, 4>& _corners, double _scale)
+{
+	// Already in the order of the destination, see orderCorners()
+	Point2f src[4];
+	for(int i = 0; i < 4; ++i)
+		src[i] = Point2f(_corners[i].x*_scale, _corners[i].y*_scale);
+
+	Point2f dst[4] = {Point2f(0,0), Point2f(1,0), Point2f(1,1), Point2f(0,1)};
+
+	table.clear();
+
+	// A flat quadrilateral (failed calibration) has no homography
+	if(fabs(contourArea(vector<Point2f>(src, src+4))) < 1.0)
+		return;
+
+	Mat h = getPerspectiveTransform(src, dst);
+
+	table.resize(kColumns*kRows);
+	for(int row = 0; row < kRows; ++row)
+		for(int column = 0; column < kColumns; ++column)
+		{
+			double x = column*kStep;
+			double y = row*kStep;
+			double w = h.at<double>(2,0)*x + h.at<double>(2,1)*y + h.at<double>(2,2);
+			table[row*kColumns+column] = Point2f((h.at<double>(0,0)*x + h.at<double>(0,1)*y + h.at<double>(0,2))/w,
+			                                     (h.at<double>(1,0)*x + h.at<double>(1,1)*y + h.at<double>(1,2))/w);
+		}
+}
+
+Point2f ScreenMapping::map(float _x, float _y) const
+{
+	float gx = min(max(_x, 0.0f), static_cast<float>(kGridWidth))/kStep;
+	float gy = min(max(_y, 0.0f), static_cast<float>(kGridHeight))/kStep;
+
+	int column = min(static_cast<int>(gx), kColumns-2);
+	int row = min(static_cast<int>(gy), kRows-2);
+	float tx = gx-column;
+	float ty = gy-row;
+
+	const Point2f* node = &table[row*kColumns+column];
+	Point2f top = node[0]*(1-tx) + node[1]*tx;
+	Point2f bottom = node[kColumns]*(1-tx) + node[kColumns+1]*tx;
+	return top*(1-ty) + bottom*ty;
+}
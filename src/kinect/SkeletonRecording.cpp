@@ -0,0 +1,165 @@
+#include "include/kinect/SkeletonRecording.h"
+
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+using namespace SkeletonRecordingFormat;
+
+namespace
+{
+	const char kMagic[8] = {'S','F','4','K','S','K','E','L'};
+
+	bool arrivedBefore(const Entry& _entry, qint64 _arrival)
+	{
+		return _entry.arrival < _arrival;
+	}
+}
+
+SkeletonRecorder::SkeletonRecorder()
+	:firstArrival(-1)
+{
+}
+
+SkeletonRecorder::~SkeletonRecorder()
+{
+	close();
+}
+
+bool SkeletonRecorder::open(const QString& _path)
+{
+	file.setFileName(_path);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qWarning() << "Cannot write" << _path;
+		return false;
+	}
+
+	//Written again by close() with the count and the index
+	Header header;
+	memset(&header, 0, sizeof(Header));
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+	index.clear();
+	firstArrival = -1;
+	return true;
+}
+
+void SkeletonRecorder::addSkeletons(const SkeletonFrame& _frame)
+{
+	add(SkeletonKind, reinterpret_cast<const char*>(&_frame), sizeof(SkeletonFrame), _frame.arrival);
+}
+
+void SkeletonRecorder::addColor(const uchar* _data, unsigned long _size, qint64 _arrival)
+{
+	add(ColorKind, reinterpret_cast<const char*>(_data), static_cast<quint32>(_size), _arrival);
+}
+
+void SkeletonRecorder::add(Kind _kind, const char* _data, quint32 _size, qint64 _arrival)
+{
+	if(!file.isOpen())
+		return;
+
+	if(firstArrival < 0)
+		firstArrival = _arrival;
+
+	qint64 offset = (file.pos()+kAlignment-1)/kAlignment*kAlignment;
+	file.write(QByteArray(static_cast<int>(offset-file.pos()), '\0'));
+	file.write(_data, _size);
+
+	Entry entry = {offset, _arrival-firstArrival, static_cast<quint32>(_kind), _size};
+	index.append(entry);
+}
+
+void SkeletonRecorder::close()
+{
+	if(!file.isOpen())
+		return;
+
+	Header header;
+	memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.frameSize = sizeof(SkeletonFrame);
+	header.count = index.size();
+	header.reserved = 0;
+	header.indexOffset = (file.pos()+kAlignment-1)/kAlignment*kAlignment;
+
+	file.write(QByteArray(static_cast<int>(header.indexOffset-file.pos()), '\0'));
+	file.write(reinterpret_cast<const char*>(index.constData()), index.size()*sizeof(Entry));
+
+	file.seek(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+	qDebug() << header.count << "frames recorded in" << file.fileName() << "(" << file.size()/1024 << "KB)";
+	file.close();
+}
+
+SkeletonRecording::SkeletonRecording()
+	:data(0),index(0),nbFrames(0)
+{
+}
+
+SkeletonRecording::~SkeletonRecording()
+{
+	close();
+}
+
+bool SkeletonRecording::open(const QString& _path)
+{
+	close();
+
+	file.setFileName(_path);
+	if(!file.open(QIODevice::ReadOnly))
+		return false;
+
+	qint64 size = file.size();
+	const uchar* map = file.map(0, size);
+	if(map == 0 || size < static_cast<qint64>(sizeof(Header)))
+	{
+		file.close();
+		return false;
+	}
+
+	Header header;
+	memcpy(&header, map, sizeof(Header));
+	if(memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion || header.frameSize != sizeof(SkeletonFrame)
+			|| header.indexOffset < static_cast<qint64>(sizeof(Header)) || header.indexOffset+header.count*static_cast<qint64>(sizeof(Entry)) > size)
+	{
+		qWarning() << _path << "is not a skeleton recording of this version";
+		file.unmap(const_cast<uchar*>(map));
+		file.close();
+		return false;
+	}
+
+	const Entry* entries = reinterpret_cast<const Entry*>(map+header.indexOffset);
+	for(quint32 i = 0; i < header.count; ++i)
+		if(entries[i].offset+entries[i].size > header.indexOffset
+				|| (entries[i].kind == SkeletonKind && entries[i].size != sizeof(SkeletonFrame)))
+		{
+			qWarning() << _path << "is corrupted";
+			file.unmap(const_cast<uchar*>(map));
+			file.close();
+			return false;
+		}
+
+	data = map;
+	index = entries;
+	nbFrames = header.count;
+	return true;
+}
+
+void SkeletonRecording::close()
+{
+	if(data != 0)
+		file.unmap(const_cast<uchar*>(data));
+	file.close();
+
+	data = 0;
+	index = 0;
+	nbFrames = 0;
+}
+
+int SkeletonRecording::find(qint64 _arrival) const
+{
+	return std::lower_bound(index, index+nbFrames, _arrival, arrivedBefore)-index;
+}
@@ -15,39 +15,46 @@
  |
  *==============================================================*/
 #include "include/kinect/qkinect.h"
+#ifdef _WIN32
+#include "include/kinect/NuiKinectSensor.h"
+#endif
 #include <QDebug>
 
-#define WORK "The device is connected and work."
-#define REFRESH_FREQUENCY 1000 / 30 // 30 fps
-
 using namespace cv;
 using namespace std;
 
-QKinect::QKinect(QSize* screenSize) :
+QKinect::QKinect(QSize* screenSize, KinectSensor* sensor) :
 	m_screenSize(screenSize),
-	m_kinect(nullptr),
-    m_hNextSkeletonEvent(INVALID_HANDLE_VALUE),
-    m_pSkeletonStreamHandle(INVALID_HANDLE_VALUE),
-	m_hNextColorFrameEvent(INVALID_HANDLE_VALUE),
-	m_pColorStreamHandle(INVALID_HANDLE_VALUE),
+	m_sensor(sensor),
+	m_recorder(nullptr),
 	m_frameColorSize(0),
 	m_frameColorData(nullptr),
+	m_colorBytes(0),
+	m_colorFrames(0),
 	m_connected(false),
 	m_run(false),
 	m_nbSkeletons(0),
 	m_calibrated(false),
 	m_ready(false),
-	m_hasToCalibrate(false)
+	m_hasToCalibrate(false),
+	m_lastTimestamp(0),
+	m_lastHandsArrival(0)
 {
+#ifdef _WIN32
+	if (m_sensor == nullptr)
+		m_sensor = new NuiKinectSensor();
+#endif
+	Q_ASSERT_X(m_sensor != nullptr, "QKinect", "no sensor given and no Kinect SDK on this platform");
 	m_ready = init();
 }
 
 QKinect::~QKinect()
 {
 	infos("destroy");
-	if (m_kinect)
-        m_kinect->NuiShutdown(); //Shutdown the kinect
 	m_run = false; //Exit the loop in the run function for kill the thread
+	wait();
+	delete m_recorder; //Writes the index of the recording
+	delete m_sensor; //Shutdown the kinect
 }
 
 /**
@@ -55,8 +62,7 @@ QKinect::~QKinect()
 */
 bool QKinect::isKinectAvailable()
 {
-	int numSensors;
-	return NuiGetSensorCount(&numSensors) == S_OK && numSensors > 0;
+	return m_sensor->isAvailable();
 }
 
 /**
@@ -65,7 +71,7 @@ bool QKinect::isKinectAvailable()
 bool QKinect::startKinect()
 {
 	infos("Kinect starting...");
-	if(m_kinect == nullptr || !m_ready) m_ready = init();
+	if(!m_ready) m_ready = init();
 
 	if(isConnected() && m_ready)
 	{
@@ -86,124 +92,98 @@ void QKinect::stopKinect()
 void QKinect::setElevationAngle(int angle)
 {
 	m_angle = angle;
-	m_kinect->NuiCameraElevationSetAngle(m_angle);
+	m_sensor->setElevationAngle(m_angle);
 }
 
 /**
-* Public methode for start calibration. Warning, you need to display a green screen for calibration.
+* Return the state of the kinect device in a human readable way
 */
-void QKinect::calibrate()
+QString QKinect::getStatutsDescription()
 {
-	m_hasToCalibrate = true;
+	return m_sensor->statusDescription();
 }
 
-void drawSquares( Mat& image, const std::array<cv::Point ,4>& points )
+/**
+* Record what the sensor delivers in a file that RecordedKinectSensor can play.
+*/
+bool QKinect::startRecording(const QString& path)
 {
-	for(auto it = points.begin(); it != points.end(); ++it)
-	{
-		circle(image, *it, 10, Scalar(255, 255, 255), 3);
-    }
+	Q_ASSERT_X(!isRunning(), "QKinect", "the recording must start before the acquisition thread");
 
-    cv::imshow("Detection", image);
+	m_recorder = new SkeletonRecorder();
+	if (m_recorder->open(path))
+		return true;
+
+	delete m_recorder;
+	m_recorder = nullptr;
+	return false;
 }
 
 /**
-* Return a QImage of the current data form the camera sensor stream
+* Set the filter of the hands. A higher minCutoff removes lag on slow moves, a higher beta on fast moves,
+* both let more jitter through. prediction extrapolates the filtered position ahead to hide the lag of the sensor.
 */
-QImage QKinect::getFrameColorCamera()
+void QKinect::setHandFilter(const HandFilter::Parameters& parameters)
 {
-	QImage image = QImage(m_frameColorData, video_width, video_height, QImage::Format::Format_RGB32);
-	if(m_frameColorSize > (video_width - 1) * video_height * 4) //check if we have the data of the image
-		image.scaled(*m_screenSize, Qt::AspectRatioMode::KeepAspectRatio);
-	else
-		image.fill(Qt::white);
+	Q_ASSERT_X(!isRunning(), "QKinect", "the filter is used by the acquisition thread");
 
-	return image;
+	for(HandFilter& filter : m_handFilters)
+	{
+		filter.setParameters(parameters);
+		filter.reset();
+	}
 }
 
 /**
-* Return a list of skeleton in coordinate for use on the computer screen (coordinate are compute by the infos of the calibration)
+* Public methode for start calibration. Warning, you need to display a green screen for calibration.
 */
-QList<QList<QPoint>> QKinect::getRealSkeletons()
+void QKinect::calibrate()
 {
-	QMutexLocker locker(&mutex);
-	QList<QList<QPoint>> realSkeletons;
-	
-	double xRatio = (m_realScreenSize.width() / (double)video_width);
-	double yRatio = (m_realScreenSize.height() / (double)video_height);
-	
-	for(QList<QPoint> skeleton : m_skeletons)
+	m_hasToCalibrate = true;
+}
+
+void drawSquares( Mat& image, const std::array<cv::Point ,4>& points )
+{
+	for(auto it = points.begin(); it != points.end(); ++it)
 	{
-		if(skeleton.count() >= 20)
-		{
-			QList<QPoint> realSkeleton;
-			for(QPoint point : skeleton)
-			{
-				double x1 = (point.x() / (double)m_screenSize->width());
-				double x2 = (m_realScreenPosition.x() / (double)video_width);
-				double y1 = (point.y() / (double)m_screenSize->height());
-				double y2 = (m_realScreenPosition.y() / (double)video_height);
-				realSkeleton << QPoint(((x1 - x2) / xRatio) * m_screenSize->width(), ((y1 - y2) / yRatio) * m_screenSize->height());
-				//qDebug() << "x1" << x1 << "\tx2" << x2 << "\ty1" << y1 << "\ty2" << y2 << "\txratio" << xRatio << "\tyRatio" << yRatio;
-				//qDebug() << "\nm_realScreenSize.width()" << m_realScreenSize.width() << "\tm_realScreenSize.height()" << m_realScreenSize.height() << "\tpoint.x()" << point.x() << "\tpoint.y()" << point.y() << "\txratio" << xRatio << "\tyRatio" << yRatio;
-			}
-			realSkeletons << realSkeleton;
-		}
-	}
+		circle(image, *it, 10, Scalar(255, 255, 255), 3);
+    }
 
-	return realSkeletons;
+    cv::imshow("Detection", image);
 }
 
 /**
-* Return a description of the status of the kinect
+* Return a QImage of the current data form the camera sensor stream, without copying it.
+* The caller scales it when it draws it, if it needs to
 */
-QString QKinect::getStatutsDescription()
+QImage QKinect::getFrameColorCamera()
 {
-	if(m_kinect == nullptr) return "Kinect not initialized";
-	if(!isKinectAvailable()) return "No Kinect available";
-	switch (m_kinect->NuiStatus())
-	{
-	case S_OK :
-		return WORK;
-	case S_NUI_INITIALIZING :
-		return "The device is connected, but still initializing.";
-	case E_NUI_NOTCONNECTED :
-		return "The device is not connected.";
-	case E_NUI_NOTGENUINE :
-		return "The device is not a valid Kinect.";
-	case E_NUI_NOTSUPPORTED :
-		return "The device is an unsupported model.";
-	case E_NUI_INSUFFICIENTBANDWIDTH :
-		return "The device is connected to a hub without the necessary bandwidth requirements.";
-	case E_NUI_NOTPOWERED :
-		return "The device is connected, but unpowered.";
-	case E_NUI_NOTREADY :
-		return "There was some other unspecified error.";
-	}
-	return "error";
+	if(m_frameColorData == nullptr || m_frameColorSize < video_width * video_height * 4) //check if we have the data of the image
+		return QImage();
+
+	return QImage(m_frameColorData, video_width, video_height, QImage::Format_RGB32);
 }
 
 /**
-* Return the hands position in computer coordinate. The hands returned are the nearest hand of the screen of each player.
+* Return the hands position in computer coordinate. The hands returned are the nearest hand of the screen of each player,
+* filtered and predicted by the Kinect thread.
 */
 QPair<QPoint, QPoint> QKinect::getHandsPosition()
 {
-	QPair<QPoint, QPoint> hands;
-	
-	int width = m_screenSize->width();
-
-	for(QList<QPoint> skeleton : getRealSkeletons())
+	const HandsFrame& frame = m_hands.read();
+	if(frame.arrival == 0)
+		return QPair<QPoint, QPoint>();
+
+	// Age of the positions when they are first used : the processing and the wait for the GUI thread,
+	// not the lag of the filter (the bench measures it on a recording). Counted once per frame : the menu and the game both read them, and newDatas also
+	// comes with the color frames
+	if(frame.arrival != m_lastHandsArrival)
 	{
-		if(skeleton.count() >= 20)
-		{
-			if(width - skeleton[NUI_SKELETON_POSITION_HEAD].x() < m_screenSize->width() / 2)
-				hands.first = (width - skeleton[NUI_SKELETON_POSITION_HAND_RIGHT].x() > width - skeleton[NUI_SKELETON_POSITION_HAND_LEFT].x()) ? QPoint(width - skeleton[NUI_SKELETON_POSITION_HAND_RIGHT].x(), skeleton[NUI_SKELETON_POSITION_HAND_RIGHT].y()) : QPoint(width - skeleton[NUI_SKELETON_POSITION_HAND_LEFT].x(), skeleton[NUI_SKELETON_POSITION_HAND_LEFT].y());
-			else
-				hands.second = (width - skeleton[NUI_SKELETON_POSITION_HAND_RIGHT].x() < width - skeleton[NUI_SKELETON_POSITION_HAND_LEFT].x()) ? QPoint(width - skeleton[NUI_SKELETON_POSITION_HAND_RIGHT].x(), skeleton[NUI_SKELETON_POSITION_HAND_RIGHT].y()) : QPoint(width - skeleton[NUI_SKELETON_POSITION_HAND_LEFT].x(), skeleton[NUI_SKELETON_POSITION_HAND_LEFT].y());
-		}
+		m_lastHandsArrival = frame.arrival;
+		m_handsAge.addSample(m_clock.nsecsElapsed() / 1000 - frame.arrival);
 	}
 
-	return hands;
+	return qMakePair(frame.first, frame.second);
 }
 
 /**
@@ -225,26 +205,31 @@ QList<QPoint> QKinect::getCorners()
 }
 
 /**
-* Methode that check each REFRESH_FREQUENCY milisecond new data from kinect.
+* Methode that waits for the frames of the kinect and processes them as soon as they are signaled.
 */
 void QKinect::run()
 {
 	m_run = true;
+	m_clock.start();
 	while(m_run)
-	{
-		update();
-		QThread::msleep(REFRESH_FREQUENCY);
-	}
+		update(m_sensor->waitForFrames(kFrameTimeout));
 }
 
 /**
-* Try to fetch new data and emit a signal if there is new data
+* Fetch the data of the ready streams and emit a signal if there is new data
 */
-void QKinect::update()
+void QKinect::update(int streams)
 {
-	if(m_kinect == nullptr) return;
-	bool update = (m_calibrated) ? false : processColor();
-	update |= processSkeleton();
+	if(streams == KinectSensor::NoStream) return;
+
+	// Stamped when the sensor signaled the frame, before any processing
+	qint64 arrival = m_clock.nsecsElapsed() / 1000;
+
+	bool update = false;
+	if(streams & KinectSensor::ColorStream)
+		update |= processColor(arrival);
+	if(streams & KinectSensor::SkeletonStream)
+		update |= processSkeleton(arrival);
 	if(update)
 		emit newDatas();
 }
@@ -254,79 +239,37 @@ void QKinect::update()
 */
 bool QKinect::init()
 {
-    if (!isKinectAvailable()) return false;
-	if (NuiCreateSensorByIndex(0, &m_kinect) < 0) return false; //Fail to create connection to the kinect
-
-    // Initialize sensor
-	HRESULT hr = m_kinect->NuiInitialize(NUI_INITIALIZE_FLAG_USES_COLOR | NUI_INITIALIZE_FLAG_USES_SKELETON); // initialize the kinect for skeletion and color, it's possible to add more than only the skeletion (e.g. camera)
-	if (SUCCEEDED(hr))
-    {
-        // Open a skeleton stream to receive skeleton data
-		hr = m_kinect->NuiSkeletonTrackingEnable(m_hNextSkeletonEvent, 0); //NUI_SKELETON_TRACKING_FLAG_ENABLE_IN_NEAR_RANGE);
-		if (FAILED(hr))
-			infos("fail to open a skeleton stream");
-		else
-		{
-			 // Create an event that will be signaled when skeleton data is available
-			m_hNextSkeletonEvent = CreateEventW(0, TRUE, FALSE, 0);
-        
-			// Open a skeleton stream to receive skeleton data
-			hr = m_kinect->NuiSkeletonTrackingEnable(m_hNextSkeletonEvent, 0); 
-		}
-
-		 // Create an event that will be signaled when color data is available
-		m_hNextColorFrameEvent = CreateEvent(0, TRUE, FALSE, 0);
-
-		hr = m_kinect->NuiImageStreamOpen(
-			NUI_IMAGE_TYPE_COLOR,            // Depth camera or rgb camera?
-			NUI_IMAGE_RESOLUTION_1280x960,    // Image resolution
-			0,      // Image stream flags, e.g. near mode
-			2,      // Number of frames to buffer
-			m_hNextColorFrameEvent,   // Event handle
-			&m_pColorStreamHandle);
-		
-		if (FAILED(hr))
-			infos("fail to open a color stream");
-		else
-			infos("A color stream is open");
-		m_connected = true;
-    }
-	else
-		infos("fail to open initialize kinect");
+	QString report;
+	m_connected = m_sensor->open(report);
+	infos(report);
 
 	setElevationAngle(7);
 
-	return getStatutsDescription() == WORK;
+	return m_sensor->isWorking();
 }
 
 /**
-* Add image the the rectangle detection class. when there is 10 images we compute the coordinate of the corners of the green screen
+* Add image the the rectangle detection class. when the corners found are stable we compute the coordinate of the corners of the green screen
 */
 void QKinect::addImage()
 {
 	static int i = 1;
 	infos(QString("Image %1").arg(i++));
-	Mat mat(video_height,video_width,CV_8UC4,m_frameColorData); // Create a mat object that use un opencv
+	Mat mat(video_height,video_width,CV_8UC4,const_cast<uchar*>(m_frameColorData)); // Create a mat object that use un opencv
 	m_rectangleDetection.addImage(mat);
 
-	if(m_rectangleDetection.getSizeImages() == kNbImages)
+	if(m_rectangleDetection.isDone())
 	{
 		m_hasToCalibrate = false;
 		m_calibrated = true;
 
 		m_points = m_rectangleDetection.getPoints();
-		m_realScreenPosition = QPoint(m_points[0].x, m_points[0].y);
-		m_realScreenSize = QSize(m_points[2].x - m_points[0].x, m_points[2].y - m_points[0].y);
+		m_mapping.calibrate(m_points, static_cast<double>(ScreenMapping::kGridWidth) / video_width);
 
 		emit calibrated();
-		
 
-		if (m_hNextColorFrameEvent != INVALID_HANDLE_VALUE)
-		{
-			CloseHandle(m_hNextColorFrameEvent); // close the color stream
-		}
 		qDebug() << QPoint(m_points[0].x, m_points[0].y) << QPoint(m_points[1].x, m_points[1].y) << QPoint(m_points[2].x, m_points[2].y) << QPoint(m_points[3].x, m_points[3].y);
-		qDebug() << m_realScreenPosition << m_realScreenSize;
+		qDebug() << "Calibrated with" << m_rectangleDetection.getSizeImages() << "images, stable :" << m_rectangleDetection.isStable();
 
 	}
 }
@@ -334,46 +277,21 @@ void QKinect::addImage()
 /**
 * Fetch the data of the skeletons in front of the kinect
 */
-bool QKinect::processSkeleton()
+bool QKinect::processSkeleton(qint64 arrival)
 {
-	QMutexLocker locker(&mutex);
-    NUI_SKELETON_FRAME skeletonFrame = {0};
-
-	HRESULT hr = m_kinect->NuiSkeletonGetNextFrame(0, &skeletonFrame); // get the new skeleton infos
-	if (FAILED(hr)) { infos("fail NuiSkeletonGetNextFrame"); return false; }
-
-    // smooth out the skeleton data
-    m_kinect->NuiTransformSmooth(&skeletonFrame, NULL);
+	SkeletonFrame& frame = m_skeletonFrame;
+	if (!m_sensor->readSkeletons(frame)) { infos("fail to read a skeleton frame"); return false; }
+	frame.arrival = arrival;
+	if (m_recorder != nullptr)
+		m_recorder->addSkeletons(frame);
 
 	m_nbSkeletons = 0;
-
-	int width = m_screenSize->width();
-	int height = m_screenSize->height();
-	
-	m_skeletons.clear();
-	for (int i = 0 ; i < NUI_SKELETON_COUNT; ++i) //fetch the skeletons
-    {
-        NUI_SKELETON_TRACKING_STATE trackingState = skeletonFrame.SkeletonData[i].eTrackingState;
-		
-		QList<QPoint> skeleton;
-
-        if (NUI_SKELETON_TRACKED == trackingState)
-        {
-            // We're tracking the skeleton
-			for (int j = 0; j < NUI_SKELETON_POSITION_COUNT; ++j)
-			{
-				skeleton << SkeletonToScreen(skeletonFrame.SkeletonData[i].SkeletonPositions[j], width, height);
-			}
+	for (int i = 0 ; i < SkeletonFrame::kSkeletonCount; ++i) //fetch the skeletons
+		if (frame.states[i] == SkeletonTracked)
 			m_nbSkeletons++;
-		
-        }
-        else if (NUI_SKELETON_POSITION_ONLY == trackingState)
-        {
-            // we've only received the center point of the skeleton
-			skeleton << SkeletonToScreen(skeletonFrame.SkeletonData[i].Position, width, height);
-		}
-		m_skeletons << skeleton;
-	}
+
+	if(m_mapping.isValid())
+		updateHands(frame);
 
 	infos(QString("%1 guy(s) in front of the kinect").arg(m_nbSkeletons));
 
@@ -383,72 +301,118 @@ bool QKinect::processSkeleton()
 /**
 * Fetch the data of the color camera stream
 */
-bool QKinect::processColor()
+bool QKinect::processColor(qint64 arrival)
 {
-    HRESULT hr;
-    NUI_IMAGE_FRAME imageFrame;
-
-    // Attempt to get the color frame
-	hr = m_kinect->NuiImageStreamGetNextFrame(m_pColorStreamHandle, 0, &imageFrame);
-	if (FAILED(hr)) { infos("fail NuiImageStreamGetNextFrame"); return false; }
-
-    INuiFrameTexture* pTexture = imageFrame.pFrameTexture;
-    NUI_LOCKED_RECT lockedRect;
-
-    // Lock the frame data so the Kinect knows not to modify it while we're reading it
-    pTexture->LockRect(0, &lockedRect, 0, 0);
-
-    // Make sure we've received valid data
-    if (lockedRect.Pitch != 0)
-    {
-        // Get the datas
-		m_frameColorData = static_cast<BYTE *>(lockedRect.pBits);
-		m_frameColorSize = lockedRect.size;
-		if(m_hasToCalibrate && !m_calibrated)
-			addImage();
-    }
+	unsigned long size = 0;
+	const uchar* data = m_sensor->lockColor(size);
+	if (data == nullptr) { infos("fail to read a color frame"); return false; }
+
+	// Get the datas
+	m_frameColorData = data;
+	m_frameColorSize = size;
+	m_colorBytes += size;
+	m_colorFrames++;
+	if(m_hasToCalibrate && !m_calibrated)
+	{
+		if (m_recorder != nullptr)
+			m_recorder->addColor(data, size, arrival);
+		addImage();
+	}
 
-    // We're done with the texture so unlock it
-    pTexture->UnlockRect(0);
+	m_sensor->unlockColor();
 
-    // Release the frame
-    m_kinect->NuiImageStreamReleaseFrame(m_pColorStreamHandle, &imageFrame);
+	// Only the calibration needs the color stream, the frame must be unlocked before it is released
+	if(m_calibrated)
+		releaseColor();
 
 	return true;
 }
 
+/**
+* Switch the sensor to the skeleton only profile and report what the color stream was costing
+*/
+void QKinect::releaseColor()
+{
+	qint64 elapsed = m_clock.elapsed();
+	m_sensor->closeColor();
+	m_frameColorData = nullptr;
+	m_frameColorSize = 0;
+
+	double megabytes = m_colorBytes / (1024.0 * 1024.0);
+	qDebug() << "Color stream released after" << m_colorFrames << "frames," << megabytes << "MB,"
+			 << (elapsed > 0 ? megabytes * 1000.0 / elapsed : 0.0) << "MB/s saved for the rest of the session";
+	infos("Skeleton only");
+}
+
+/**
+* Select the hand of each player, map it to the screen and filter it, then publish the result for the GUI thread
+*/
+void QKinect::updateHands(const SkeletonFrame& frame)
+{
+	int width = m_screenSize->width();
+	int height = m_screenSize->height();
+
+	// Only the three joints the game uses go through the mapping
+	QPoint raw[2];
+	bool found[2] = {false, false};
+	for(int i = 0; i < SkeletonFrame::kSkeletonCount; ++i)
+	{
+		if(frame.states[i] != SkeletonTracked)
+			continue;
+
+		QPoint head = JointToScreen(frame.joints[i][JointHead], width, height);
+		QPoint left = JointToScreen(frame.joints[i][JointHandLeft], width, height);
+		QPoint right = JointToScreen(frame.joints[i][JointHandRight], width, height);
+
+		if(head.x() < width / 2)
+		{
+			raw[0] = (right.x() > left.x()) ? right : left;
+			found[0] = true;
+		}
+		else
+		{
+			raw[1] = (right.x() < left.x()) ? right : left;
+			found[1] = true;
+		}
+	}
+
+	// The sensor timestamps give the real spacing of the frames, even when some are dropped
+	qreal dt = (m_lastTimestamp != 0 && frame.timestamp > m_lastTimestamp) ? (frame.timestamp - m_lastTimestamp) / 1000.0 : 1.0 / 30.0;
+	m_lastTimestamp = frame.timestamp;
+
+	HandsFrame& hands = m_hands.writeBuffer();
+	QPoint* positions[2] = {&hands.first, &hands.second};
+	for(int i = 0; i < 2; ++i)
+	{
+		if(found[i])
+			*positions[i] = m_handFilters[i].filter(raw[i], dt).toPoint();
+		else
+		{
+			*positions[i] = QPoint();
+			m_handFilters[i].reset(); // The player left, don't extrapolate from the old position
+		}
+	}
+	hands.arrival = frame.arrival;
+	m_hands.publish();
+}
+
 void QKinect::infos(QString message)
 {
-	int val = 0;
-	NuiGetSensorCount(&val);
-	
-	message = QString("%1 | %2 | %3 Kinect(s) available").arg(message).arg(getStatutsDescription()).arg(val);
+	message = QString("%1 | %2 | %3 Kinect(s) available").arg(message).arg(getStatutsDescription()).arg(m_sensor->sensorCount());
 	emit updateInfo(message);
 }
 
-////////////////////////////
-/// MICROSOFT KINECT SDK ///
-////////////////////////////
 /// <summary>
-/// Converts a skeleton point to screen space
+/// Converts a skeleton point to the computer screen, through the green screen found by the calibration.
+/// The screen is seen from behind by the Kinect, so x is mirrored
 /// </summary>
 /// <param name="skeletonPoint">skeleton point to tranform</param>
 /// <param name="width">width (in pixels) of output buffer</param>
 /// <param name="height">height (in pixels) of output buffer</param>
 /// <returns>point in screen-space</returns>
-QPoint QKinect::SkeletonToScreen(Vector4 skeletonPoint, int width, int height)
+QPoint QKinect::JointToScreen(const JointPosition& skeletonPoint, int width, int height) const
 {
-    LONG x, y;
-    USHORT depth;
-
-    // Calculate the skeleton's position on the screen
-    // NuiTransformSkeletonToDepthImage returns coordinates in NUI_IMAGE_RESOLUTION_320x240 space
-    NuiTransformSkeletonToDepthImage(skeletonPoint, &x, &y, &depth);
-	//qDebug() << QString("(%1,%2) - %3").arg(x).arg(y);
-	//qDebug() << QString("w: %1, x: %2, y: %3, z: %4").arg(skeletonPoint.w).arg(skeletonPoint.x).arg(skeletonPoint.y).arg(skeletonPoint.z);
-
-	float screenPointX = static_cast<float>(x * width) / cScreenWidth;
-	float screenPointY = static_cast<float>(y * height) / cScreenHeight;
-
-    return QPoint(screenPointX, screenPointY);
+	Point2f depthPoint = m_sensor->toDepthImage(skeletonPoint);
+	Point2f screenPoint = m_mapping.map(depthPoint.x, depthPoint.y);
+	return QPoint(width - screenPoint.x * width, screenPoint.y * height);
 }
@@ -2,9 +2,36 @@
 #include "include/menu/ConnectDialog.h"
 #include "include/menu/KinectWindow.h"
 #include "include/kinect/qkinect.h"
+#include "include/kinect/RecordedKinectSensor.h"
+#include "include/utils/SpriteArchive.h"
 
-int main(int, char**)
+int main(int _argc, char** _argv)
 {
+	//Build step : decodes the resources once for all in an archive mapped at startup
+	if(_argc == 3 && QString(_argv[1]) == "--pack-sprites")
+	{
+		QCoreApplication core(_argc, _argv);
+		return SpriteArchive::pack(QString::fromLocal8Bit(_argv[2])) ? 0 : 1;
+	}
+
+	//Kinect recording (--record <file>) or playback instead of the Kinect (--playback <file> [speed])
+	QString recordPath, playbackPath;
+	qreal playbackSpeed = 1.0;
+	for(int i = 1; i+1 < _argc; ++i)
+	{
+		if(QString(_argv[i]) == "--record")
+			recordPath = QString::fromLocal8Bit(_argv[i+1]);
+		else if(QString(_argv[i]) == "--playback")
+		{
+			playbackPath = QString::fromLocal8Bit(_argv[i+1]);
+
+			bool isSpeed = false;
+			qreal speed = (i+2 < _argc) ? QString(_argv[i+2]).toDouble(&isSpeed) : 0.0;
+			if(isSpeed && speed >= 0.0)
+				playbackSpeed = speed;
+		}
+	}
+
 	char *argv[] = {"Starfighter4K","-platformpluginpath", ".", NULL};
 	int argc = sizeof(argv) / sizeof(char*) - 1;
     QApplication app(argc, argv);
@@ -16,11 +43,17 @@ int main(int, char**)
     QDir dir(SOUNDS_DIR);
     if(!dir.exists())
         QMessageBox::information(0, QObject::tr("Sounds not found"), QObject::tr("The sounds directory was not found. The game will work as it should, but no sound will be played."));
+
+    //Without the archive the sprites are decoded from the resources, slower but the same
+    if(!SpriteArchive::global().open(SPRITE_ARCHIVE))
+        qDebug() << "No sprite archive, the sprites will be decoded at runtime";
         
     WiimoteEngine we;
     // New Kinect menus
 	QSize size = app.desktop()->screenGeometry().size();
-	QKinect kinect(&size);
+	QKinect kinect(&size, playbackPath.isEmpty() ? nullptr : new RecordedKinectSensor(playbackPath, playbackSpeed));
+	if(!recordPath.isEmpty())
+		kinect.startRecording(recordPath);
     ConnectDialog cd(&we, &kinect);
     KinectWindow* kw;
     if(cd.exec() == QDialog::Accepted)
@@ -1,13 +1,18 @@
 #include "include/menu/BlurPushButton.h"
+#include "include/utils/SpriteArchive.h"
+#include "include/config/Define.h"
 
-QImage BlurPushButton::original(":/images/menu/background");
+const QImage& BlurPushButton::original()
+{
+	//Loaded on first use, once the sprite archive is opened
+	static QImage image = SpriteArchive::loadImage(MENU_BACKGROUND);
+	return image;
+}
 
 BlurPushButton::BlurPushButton(QWidget *parent)
-	: QPushButton(parent),  handOnTop(false)
+	: QPushButton(parent),  handOnTop(false), progress(0)
 {
 	setStyleSheet("*{background-color:rgba(0,0,0,0);}");
-	timer.setInterval(50);
-	connect(&timer, &QTimer::timeout, this, &BlurPushButton::clockTick);
 }
 
 BlurPushButton::~BlurPushButton()
@@ -15,12 +20,15 @@ BlurPushButton::~BlurPushButton()
 
 }
 
-void BlurPushButton::clockTick()
+void BlurPushButton::dwell()
 {
+	//Back to 0 once clicked, the hand has to leave the button to click it again
+	if(!handOnTop || progress == 0)
+		return;
+
 	progress += 1;
-	if(progress >= 30)
+	if(progress >= MENU_DWELL_STEPS)
 	{
-		timer.stop();
 		click();
 
 		progress = 0;
@@ -30,17 +38,10 @@ void BlurPushButton::clockTick()
 
 void BlurPushButton::setHandOnTop(bool isOnTop)
 {
-	if(isOnTop && !handOnTop)
-	{
-		timer.start();
-		progress = 5;
-	}
-	else if(!isOnTop)
-	{
-		progress = 0;
-		timer.stop();
-	}
-	
+	if(isOnTop == handOnTop)
+		return;
+
+	progress = isOnTop ? 5 : 0;
 	handOnTop = isOnTop;
 
 	update();
@@ -48,7 +49,7 @@ void BlurPushButton::setHandOnTop(bool isOnTop)
 
 void BlurPushButton::resizeEvent(QResizeEvent* event)
 {
-	background = blurred(original, QRect(mapToGlobal(rect().topLeft()), event->size()), 20, false);
+	background = blurred(original(), QRect(mapToGlobal(rect().topLeft()), event->size()), 20, false);
 	blur = QPixmap(event->size());
 	blur.fill(QColor(168,195,205,20*2.55));
 
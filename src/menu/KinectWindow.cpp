@@ -5,6 +5,8 @@
 #include "include/engine/GameEngine.h"
 #include "include/kinect/qkinect.h"
 #include "include/utils/Settings.h"
+#include "include/utils/ResourcePrewarmer.h"
+#include "include/utils/SpriteCache.h"
 #include "include/config/Define.h"
 
 KinectWindow::KinectWindow(WiimoteEngine *we, QKinect* kinect, QWidget *parent) :
@@ -12,9 +14,10 @@ KinectWindow::KinectWindow(WiimoteEngine *we, QKinect* kinect, QWidget *parent)
 	ui(new Ui::KinectWindow),
 	p1Ship(NoSpaceShip), p2Ship(NoSpaceShip),
 	p1Bonus(TypeSpecialBonusNothing), p2Bonus(TypeSpecialBonusNothing),
-	we(we), kinect(kinect), ge(0),
-	background(":/images/menu/background"),
-	kinectActive(true)
+	we(we), kinect(kinect), ge(0), prewarmer(new ResourcePrewarmer(this)),
+	background(SpriteCache::pixmap(MENU_BACKGROUND)),
+	kinectActive(true),
+	hitButtonsDirty(true)
 {
 	ui->setupUi(this);
 	setAttribute(Qt::WA_TranslucentBackground);
@@ -34,6 +37,11 @@ KinectWindow::KinectWindow(WiimoteEngine *we, QKinect* kinect, QWidget *parent)
 	updateTimerDisplay();
 
 	connect(kinect, SIGNAL(newDatas()), this, SLOT(handsMoved()));
+	connect(ui->stack, SIGNAL(currentChanged(int)), this, SLOT(pageChanged()));
+
+	dwellClock.setInterval(MENU_DWELL_TICK);
+	connect(&dwellClock, SIGNAL(timeout()), this, SLOT(dwellTick()));
+	connect(prewarmer, SIGNAL(finished()), this, SLOT(prewarmFinished()));
 
 	connect(ui->btnBackBonus, SIGNAL(clicked()), this, SLOT(back()));
 	connect(ui->btnBackMode, SIGNAL(clicked()), this, SLOT(back()));
@@ -108,6 +116,52 @@ void KinectWindow::paintEvent(QPaintEvent *event)
 	p.drawPixmap(0, 0, background);
 }
 
+void KinectWindow::resizeEvent(QResizeEvent *event)
+{
+	QMainWindow::resizeEvent(event);
+	hitButtonsDirty = true;
+}
+
+void KinectWindow::pageChanged()
+{
+	hitButtonsDirty = true;
+}
+
+void KinectWindow::indexButtons()
+{
+	hitButtons.clear();
+	foreach(BlurPushButton* button, ui->stack->currentWidget()->findChildren<BlurPushButton*>())
+	{
+		if(button->isVisible())
+			hitButtons.append(qMakePair(QRect(button->mapTo(this, QPoint(0, 0)), button->size()), button));
+	}
+	hitButtonsDirty = false;
+}
+
+BlurPushButton* KinectWindow::buttonAt(const QPoint& point) const
+{
+	//Last created on top, like childAt()
+	for(int i = hitButtons.size() - 1; i >= 0; --i)
+	{
+		if(hitButtons[i].first.contains(point))
+			return hitButtons[i].second;
+	}
+	return 0;
+}
+
+void KinectWindow::hover(int hand, BlurPushButton* button)
+{
+	BlurPushButton* previous = hoverButtons[hand];
+	if(previous == button)
+		return;
+
+	hoverButtons[hand] = button;
+	if(previous != 0 && previous != hoverButtons[1 - hand])
+		previous->setHandOnTop(false);
+	if(button != 0)
+		button->setHandOnTop(true);
+}
+
 void KinectWindow::handsMoved()
 {
 	if(!kinectActive)
@@ -117,32 +171,34 @@ void KinectWindow::handsMoved()
 	hand1 = hands.first;
 	hand2 = hands.second;
 
-	BlurPushButton* button1;
-	if(button1 = dynamic_cast<BlurPushButton*>(childAt(hand1)))
-	{
-		if(hoverButtons[0] != 0 && hoverButtons[0] != button1)
-			hoverButtons[0]->setHandOnTop(false);
-		button1->setHandOnTop(true);
-		hoverButtons[0] = button1;
-	}
-	else if(hoverButtons[0] != 0)
-		hoverButtons[0]->setHandOnTop(false);
-	BlurPushButton* button2;
-	if(button2 = dynamic_cast<BlurPushButton*>(childAt(hand2)))
-	{
-		if(hoverButtons[1] != 0 && hoverButtons[1] != button2)
-			hoverButtons[1]->setHandOnTop(false);
-		button2->setHandOnTop(true);
-		hoverButtons[1] = button2;
-	}
-	else if(hoverButtons[1] != 0)
-		hoverButtons[1]->setHandOnTop(false);
+	if(hitButtonsDirty)
+		indexButtons();
+
+	hover(0, buttonAt(hand1));
+	hover(1, buttonAt(hand2));
+
+	if(hoverButtons[0] == 0 && hoverButtons[1] == 0)
+		dwellClock.stop();
+	else if(!dwellClock.isActive())
+		dwellClock.start();
+}
+
+void KinectWindow::dwellTick()
+{
+	//A click may change the page, its buttons are hidden until the next hands update
+	if(hoverButtons[0] != 0 && hoverButtons[0]->isVisible())
+		hoverButtons[0]->dwell();
+	if(hoverButtons[1] != 0 && hoverButtons[1] != hoverButtons[0] && hoverButtons[1]->isVisible())
+		hoverButtons[1]->dwell();
 }
 
 void KinectWindow::on_btnGame_clicked()
 {
 	ui->graphicsView->escapeGame();
 	ui->stack->setCurrentWidget(ui->mode);
+
+	//The players need a few seconds to choose, the game is loaded meanwhile
+	prewarmer->start();
 }
 
 void KinectWindow::on_btnOptions_clicked()
@@ -286,12 +342,28 @@ void KinectWindow::validateBonus(int)
 		p2Bonus = (TypeSpecialBonus)p2BonusId;
 
 		kinectActive = false;
+		hover(0, 0);
+		hover(1, 0);
+		dwellClock.stop();
 
 		menuMusic->stop();
 		int duration = timer.hour() * 3600 + timer.minute() * 60 + timer.second();
 		int difficulty = AlienMothership | Asteroids | Satellites | Supernovae | BlackSquadron;
-		ge = new GameEngine(we, kinect, gameMode, duration, p1Ship, p2Ship, p1Bonus, p2Bonus, difficulty, this);
-		connect(ge, SIGNAL(endGame()), this, SLOT(endGame()));
+		//Only blocks if the players were faster than the loading
+		prewarmer->waitForFinished();
+		prewarmFinished();
+		ge->newMatch(gameMode, duration, p1Ship, p2Ship, p1Bonus, p2Bonus, difficulty);
+	}
+}
+
+void KinectWindow::prewarmFinished()
+{
+	//The sprites are in the cache, the window, the scene and the sound voices are built now (GUI thread only)
+	if(ge == 0)
+	{
+		ge = new GameEngine(we, kinect, this);
+		//Queued : the end of the game is asked from the controls of the match that endMatch() deletes
+		connect(ge, SIGNAL(endGame()), this, SLOT(endGame()), Qt::QueuedConnection);
 	}
 }
 
@@ -299,8 +371,7 @@ void KinectWindow::endGame()
 {
 	ui->graphicsView->escapeGame();
 
-	ge->deleteLater();
-	ge = 0;
+	ge->endMatch();//The engine is kept for the next match
 
 	unselectBonuses();
 	unselectShips();
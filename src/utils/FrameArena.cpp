@@ -0,0 +1,56 @@
+#include "include/utils/FrameArena.h"
+
+FrameArena::FrameArena(size_t _blockSize)
+    :blockSize(_blockSize),current(0),offset(0),used(0),peak(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    for(int i = 0;i<blocks.size();++i)
+        ::operator delete(blocks[i].data);
+}
+
+void* FrameArena::allocate(size_t _size, size_t _align)
+{
+    while(current < blocks.size())
+    {
+        Block& block = blocks[current];
+        quintptr begin = reinterpret_cast<quintptr>(block.data);
+        quintptr aligned = (begin+offset+_align-1) & ~static_cast<quintptr>(_align-1);
+
+        if(aligned+_size <= begin+block.size)
+        {
+            used += aligned+_size-(begin+offset);
+            offset = aligned+_size-begin;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        //Not enough room at the end of this block, the rest is lost until the next reset
+        ++current;
+        offset = 0;
+    }
+
+    Block block;
+    block.size = qMax(blockSize, _size+_align);
+    block.data = static_cast<char*>(::operator new(block.size));
+    blocks.append(block);
+
+    return allocate(_size, _align);
+}
+
+void FrameArena::reset()
+{
+    peak = qMax(peak, used);
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+size_t FrameArena::capacity() const
+{
+    size_t total = 0;
+    for(int i = 0;i<blocks.size();++i)
+        total += blocks[i].size;
+    return total;
+}
@@ -0,0 +1,58 @@
+#include "include/utils/LatencyStats.h"
+
+#include <QVector>
+#include <algorithm>
+
+LatencyStats::LatencyStats()
+    :next(0),nbSamples(0),minValue(0),maxValue(0),total(0)
+{
+}
+
+void LatencyStats::addSample(qint64 _value)
+{
+    if(nbSamples == 0 || _value < minValue)
+        minValue = _value;
+    if(nbSamples == 0 || _value > maxValue)
+        maxValue = _value;
+
+    total += _value;
+    ++nbSamples;
+
+    window[next] = _value;
+    next = (next+1) % kWindow;
+}
+
+void LatencyStats::clear()
+{
+    next = nbSamples = 0;
+    minValue = maxValue = total = 0;
+}
+
+qreal LatencyStats::average() const
+{
+    return nbSamples == 0 ? 0.0 : static_cast<qreal>(total)/nbSamples;
+}
+
+qint64 LatencyStats::percentile(qreal _p) const
+{
+    int size = qMin(nbSamples, static_cast<int>(kWindow));
+    if(size == 0)
+        return 0;
+
+    //nth_element works on a copy, only summaries ask for it
+    QVector<qint64> sorted(size);
+    std::copy(window, window+size, sorted.begin());
+    int rank = qBound(0, static_cast<int>(ceil(_p/100.0*size))-1, size-1);
+    std::nth_element(sorted.begin(), sorted.begin()+rank, sorted.end());
+    return sorted[rank];
+}
+
+QString LatencyStats::summary(const QString& _unit) const
+{
+    return QString("n=%1 min=%2%5 avg=%3%5 p99=%4%5")
+            .arg(count())
+            .arg(minimum())
+            .arg(average(), 0, 'f', 1)
+            .arg(percentile(99.0))
+            .arg(_unit);
+}
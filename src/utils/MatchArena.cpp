@@ -0,0 +1,140 @@
+#include "include/utils/MatchArena.h"
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+    struct Header
+    {
+        MatchArena* arena;
+        size_t size;
+    };
+}
+
+MatchArena::MatchArena(size_t _chunkSize)
+    :chunkSize(_chunkSize),current(-1),offset(_chunkSize),live(0)
+{
+    memset(freeLists, 0, sizeof(freeLists));
+}
+
+MatchArena::~MatchArena()
+{
+    release();
+}
+
+void* MatchArena::allocate(size_t _size)
+{
+    size_t sizeClass = (_size+kGranularity-1)/kGranularity;
+    ++live;
+
+    //Oversized objects get a block of their own, the smallest free one that fits or a new one
+    if(sizeClass >= static_cast<size_t>(kNbClasses))
+    {
+        int best = -1;
+        for(int i = 0;i<freeLargeBlocks.size();++i)
+            if(freeLargeBlocks[i].size >= _size && (best == -1 || freeLargeBlocks[i].size < freeLargeBlocks[best].size))
+                best = i;
+
+        if(best != -1)
+        {
+            char* block = freeLargeBlocks[best].data;
+            freeLargeBlocks.remove(best);
+            return block;
+        }
+
+        LargeBlock block = {static_cast<char*>(::operator new(_size)), _size};
+        largeBlocks.append(block);
+        return block.data;
+    }
+
+    if(freeLists[sizeClass] != 0)
+    {
+        FreeNode* node = freeLists[sizeClass];
+        freeLists[sizeClass] = node->next;
+        return node;
+    }
+
+    size_t blockSize = sizeClass*kGranularity;
+    if(offset+blockSize > chunkSize)
+    {
+        if(++current == chunks.size())
+            chunks.append(static_cast<char*>(::operator new(chunkSize)));
+        offset = 0;
+    }
+
+    void* block = chunks[current]+offset;
+    offset += blockSize;
+    return block;
+}
+
+void MatchArena::free(void* _p, size_t _size)
+{
+    size_t sizeClass = (_size+kGranularity-1)/kGranularity;
+    --live;
+
+    if(sizeClass >= static_cast<size_t>(kNbClasses))
+    {
+        for(int i = 0;i<largeBlocks.size();++i)
+            if(largeBlocks[i].data == _p)
+            {
+                freeLargeBlocks.append(largeBlocks[i]);
+                break;
+            }
+        return;
+    }
+
+    FreeNode* node = static_cast<FreeNode*>(_p);
+    node->next = freeLists[sizeClass];
+    freeLists[sizeClass] = node;
+}
+
+void MatchArena::reset()
+{
+    freeLargeBlocks = largeBlocks;
+
+    memset(freeLists, 0, sizeof(freeLists));
+    current = -1;
+    offset = chunkSize;
+    live = 0;
+}
+
+void MatchArena::release()
+{
+    reset();
+
+    for(int i = 0;i<largeBlocks.size();++i)
+        ::operator delete(largeBlocks[i].data);
+    largeBlocks.clear();
+    freeLargeBlocks.clear();
+
+    for(int i = 0;i<chunks.size();++i)
+        ::operator delete(chunks[i]);
+    chunks.clear();
+}
+
+void* MatchArena::allocateTagged(MatchArena* _arena, size_t _size)
+{
+    size_t size = _size+kHeaderSize;
+    char* block = static_cast<char*>(_arena != 0 ? _arena->allocate(size) : ::operator new(size));
+
+    Header* header = reinterpret_cast<Header*>(block);
+    header->arena = _arena;
+    header->size = size;
+
+    return block+kHeaderSize;
+}
+
+void MatchArena::freeTagged(void* _p)
+{
+    if(_p == 0)
+        return;
+
+    char* block = static_cast<char*>(_p)-kHeaderSize;
+    Header* header = reinterpret_cast<Header*>(block);
+
+    if(header->arena != 0)
+        header->arena->free(block, header->size);
+    else
+        ::operator delete(block);
+}
@@ -0,0 +1,27 @@
+#include "include/utils/PowerSteps.h"
+#include "include/config/Define.h"
+
+#include <QMap>
+
+namespace
+{
+const QVector<qreal>* powerTable(qreal _power)
+{
+    static QMap<qreal, QVector<qreal> > tables;
+
+    auto it = tables.find(_power);
+    if(it == tables.end())
+    {
+        QVector<qreal> l_table(MULTI_POWER_TABLE_SIZE);
+        for(int i = 0;i<MULTI_POWER_TABLE_SIZE;i++)
+            l_table[i] = pow(static_cast<qreal>(i), _power);
+        it = tables.insert(_power, l_table);
+    }
+    return &it.value();
+}
+}
+
+PowerSteps::PowerSteps(qreal _power)
+    :power(_power),table(powerTable(_power))
+{
+}
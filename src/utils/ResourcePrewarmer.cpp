@@ -0,0 +1,113 @@
+#include "include/utils/ResourcePrewarmer.h"
+#include "include/utils/SpriteCache.h"
+#include "include/utils/SpriteArchive.h"
+#include "include/config/Define.h"
+
+#include <QRunnable>
+
+class ResourcePrewarmer::DecodeTask : public QRunnable
+{
+public:
+    DecodeTask(ResourcePrewarmer* _prewarmer, const QString& _path)
+        :prewarmer(_prewarmer),path(_path) {}
+
+    void run()
+    {
+        //Premultiplied is the format the raster and GL paint engines draw from, the upload is a plain copy.
+        //An image of the archive is a view on the mapping, bits() copies it here rather than on the GUI thread
+        QImage image = SpriteArchive::loadImage(path);
+        image.bits();
+        prewarmer->addDecoded(path, image);
+    }
+
+private:
+    ResourcePrewarmer* prewarmer;
+    QString path;
+};
+
+ResourcePrewarmer::ResourcePrewarmer(QObject *parent)
+    :QObject(parent),pending(0),started(false),done(false)
+{
+}
+
+ResourcePrewarmer::~ResourcePrewarmer()
+{
+    pool.waitForDone();
+}
+
+QStringList ResourcePrewarmer::gameSprites()
+{
+    QStringList sprites;
+    sprites << BACKGROUND
+            << PICTURE_SPACESHIP_1 << PICTURE_SPACESHIP_2 << PICTURE_SPACESHIP_3 << PICTURE_SHIELD
+            << PICTURE_PROJ_SPACESHIP_1 << PICTURE_PROJ_SPACESHIP_2 << PICTURE_PROJ_SPACESHIP_3
+            << PICTURE_PROJ_GUIDED << PICTURE_PROJ_BLACKSHIP
+            << PICTURE_ALIENSPACESHIP << PICTURE_BONUS << PICTURE_BLACKSHIP;
+
+    for(int i = NB_PICTURE_ASTEROID_MIN;i<=NB_PICTURE_ASTEROID_MAX;++i)
+        sprites << QString(PICTURE_ASTEROID).arg(i);
+    for(int i = NB_PICTURE_SMALL_ASTEROID_MIN;i<=NB_PICTURE_SMALL_ASTEROID_MAX;++i)
+        sprites << QString(PICTURE_SMALL_ASTEROID).arg(i);
+    for(int i = NB_PICTURE_SUPERNOVA_ASTEROID_MIN;i<=NB_PICTURE_SUPERNOVA_ASTEROID_MAX;++i)
+        sprites << QString(PICTURE_SUPERNOVA_ASTEROID).arg(i);
+
+    return sprites;
+}
+
+void ResourcePrewarmer::start()
+{
+    if(started)
+        return;
+    started = true;
+    chrono.start();
+
+    QStringList sprites = gameSprites();
+    for(auto it = sprites.begin(); it != sprites.end(); ++it)
+        if(!SpriteCache::contains(*it))
+        {
+            ++pending;
+            pool.start(new DecodeTask(this, *it));
+        }
+
+    if(pending == 0)
+        imagesDecoded();
+}
+
+void ResourcePrewarmer::waitForFinished()
+{
+    if(!started)
+        start();
+
+    pool.waitForDone();
+    imagesDecoded();
+}
+
+void ResourcePrewarmer::addDecoded(const QString& path, const QImage& image)
+{
+    QMutexLocker l(&mutex);
+    decoded.append(qMakePair(path, image));
+
+    //Only one pending call for all the images decoded in the meantime
+    if(decoded.size() == 1)
+        QMetaObject::invokeMethod(this, "imagesDecoded", Qt::QueuedConnection);
+}
+
+void ResourcePrewarmer::imagesDecoded()
+{
+    QList<QPair<QString, QImage> > images;
+    {
+        QMutexLocker l(&mutex);
+        images.swap(decoded);
+    }
+
+    for(auto it = images.begin(); it != images.end(); ++it)
+        SpriteCache::insert(it->first, QPixmap::fromImage(it->second));
+    pending -= images.size();
+
+    if(pending == 0 && !done)
+    {
+        done = true;
+        qDebug() << "Game resources prewarmed in" << chrono.elapsed() << "ms";
+        emit finished();
+    }
+}
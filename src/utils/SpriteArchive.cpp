@@ -0,0 +1,146 @@
+#include "include/utils/SpriteArchive.h"
+
+#include <QDataStream>
+#include <QDirIterator>
+#include <QImageReader>
+#include <cstring>
+
+namespace
+{
+    const char kMagic[8] = {'S','F','4','K','S','P','R','K'};
+}
+
+SpriteArchive::SpriteArchive()
+    :data(0)
+{
+}
+
+SpriteArchive::~SpriteArchive()
+{
+    if(data != 0)
+        file.unmap(const_cast<uchar*>(data));
+}
+
+SpriteArchive& SpriteArchive::global()
+{
+    static SpriteArchive archive;
+    return archive;
+}
+
+bool SpriteArchive::open(const QString& _path)
+{
+    file.setFileName(_path);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    qint64 size = file.size();
+    const uchar* map = file.map(0, size);
+    if(map == 0 || size < static_cast<qint64>(sizeof(Header)))
+    {
+        file.close();
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, map, sizeof(Header));
+    if(memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion
+            || header.indexOffset < static_cast<qint64>(sizeof(Header)) || header.indexOffset > size)
+    {
+        qWarning() << _path << "is not a sprite archive of this version";
+        file.unmap(const_cast<uchar*>(map));
+        file.close();
+        return false;
+    }
+
+    QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char*>(map)+header.indexOffset, size-header.indexOffset);
+    QDataStream stream(raw);
+    stream.setVersion(QDataStream::Qt_5_1);
+
+    for(quint32 i = 0;i<header.count;++i)
+    {
+        QString name;
+        Entry entry;
+        stream >> name >> entry.width >> entry.height >> entry.bytesPerLine >> entry.offset;
+
+        if(stream.status() != QDataStream::Ok || entry.offset+static_cast<qint64>(entry.bytesPerLine)*entry.height > header.indexOffset)
+        {
+            qWarning() << _path << "is corrupted";
+            index.clear();
+            file.unmap(const_cast<uchar*>(map));
+            file.close();
+            return false;
+        }
+        index.insert(name, entry);
+    }
+
+    data = map;
+    return true;
+}
+
+QImage SpriteArchive::image(const QString& _name) const
+{
+    QHash<QString, Entry>::const_iterator it = index.constFind(_name);
+    if(it == index.constEnd())
+        return QImage();
+
+    //Read-only view on the mapping, the image is copied if someone writes into it
+    const Entry& entry = it.value();
+    return QImage(data+entry.offset, entry.width, entry.height, entry.bytesPerLine, QImage::Format_ARGB32_Premultiplied);
+}
+
+QImage SpriteArchive::loadImage(const QString& _name)
+{
+    if(global().contains(_name))
+        return global().image(_name);
+    return QImage(_name).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+bool SpriteArchive::pack(const QString& _path)
+{
+    QFile out(_path);
+    if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Cannot write" << _path;
+        return false;
+    }
+
+    Header header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.count = 0;
+    header.indexOffset = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    QByteArray indexData;
+    QDataStream stream(&indexData, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_1);
+
+    QDirIterator it(":/images", QDirIterator::Subdirectories);
+    while(it.hasNext())
+    {
+        QString name = it.next();
+        if(it.fileInfo().isDir())
+            continue;
+
+        QImageReader reader(name);
+        QImage image = reader.read().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        if(image.isNull())
+            continue;
+
+        qint64 offset = (out.pos()+kAlignment-1)/kAlignment*kAlignment;
+        out.write(QByteArray(static_cast<int>(offset-out.pos()), '\0'));
+        out.write(reinterpret_cast<const char*>(image.constBits()), image.byteCount());
+
+        stream << name << qint32(image.width()) << qint32(image.height()) << qint32(image.bytesPerLine()) << offset;
+        ++header.count;
+    }
+
+    header.indexOffset = out.pos();
+    out.write(indexData);
+
+    out.seek(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    qDebug() << header.count << "sprites packed in" << _path << "(" << out.size()/1024 << "KB)";
+    return out.error() == QFile::NoError;
+}
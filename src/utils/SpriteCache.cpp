@@ -0,0 +1,49 @@
+#include "include/utils/SpriteCache.h"
+#include "include/utils/SpriteArchive.h"
+#include "include/config/Define.h"
+
+QHash<QString, QPixmap> SpriteCache::sprites;
+QHash<qint64, QVector<QPixmap> > SpriteCache::rotations;
+
+const QPixmap& SpriteCache::pixmap(const QString& _path)
+{
+    QHash<QString, QPixmap>::const_iterator it = sprites.constFind(_path);
+    if(it != sprites.constEnd())
+        return it.value();
+
+    return *sprites.insert(_path, QPixmap::fromImage(SpriteArchive::loadImage(_path)));
+}
+
+bool SpriteCache::contains(const QString& _path)
+{
+    return sprites.contains(_path);
+}
+
+void SpriteCache::insert(const QString& _path, const QPixmap& _pixmap)
+{
+    sprites.insert(_path, _pixmap);
+}
+
+const QPixmap& SpriteCache::rotated(const QPixmap& _sprite, qreal _degrees)
+{
+    int bin = qRound(_degrees*SPRITE_ROTATION_BINS/360.0) % SPRITE_ROTATION_BINS;
+    if(bin < 0)
+        bin += SPRITE_ROTATION_BINS;
+    if(bin == 0)
+        return _sprite;
+
+    QVector<QPixmap>& bins = rotations[_sprite.cacheKey()];
+    if(bins.isEmpty())
+        bins.resize(SPRITE_ROTATION_BINS);
+
+    QPixmap& rotatedSprite = bins[bin];
+    if(rotatedSprite.isNull())
+        rotatedSprite = _sprite.transformed(QTransform().rotate(bin*360.0/SPRITE_ROTATION_BINS), Qt::SmoothTransformation);
+    return rotatedSprite;
+}
+
+void SpriteCache::clear()
+{
+    sprites.clear();
+    rotations.clear();
+}
@@ -0,0 +1,43 @@
+#include "tests/Tests.h"
+
+int checkThat(bool _condition, const char* _expression, const char* _file, int _line)
+{
+    if(!_condition)
+        qDebug() << "FAILED" << _expression << "at" << _file << _line;
+    return _condition ? 0 : 1;
+}
+
+void runEventLoop(int _ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(_ms, &loop, SLOT(quit()));
+    loop.exec();
+}
+
+bool runEventLoopUntil(const std::function<bool()>& _condition, int _timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while(!_condition())
+    {
+        if(timer.elapsed() > _timeoutMs)
+            return false;
+        runEventLoop(1);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int failures = 0;
+    failures += testLatencyStats();
+    failures += testNullAudioSink();
+    failures += testSoundEngineNullSink();
+    failures += testStepRotation();
+    failures += testProjectileMultiPowers();
+
+    qDebug() << (failures == 0 ? "All tests passed" : "Some tests failed :") << failures << "failed check(s)";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include "tests/Tests.h"
+#include "include/utils/LatencyStats.h"
+#include "include/engine/NullAudioSink.h"
+#include "include/engine/SoundEngine.h"
+#include "include/config/Define.h"
+
+namespace
+{
+    QAudioFormat cdFormat()
+    {
+        QAudioFormat format;
+        format.setSampleRate(44100);
+        format.setChannelCount(2);
+        format.setSampleSize(16);
+        format.setCodec("audio/pcm");
+        format.setByteOrder(QAudioFormat::LittleEndian);
+        format.setSampleType(QAudioFormat::SignedInt);
+        return format;
+    }
+
+    //A stream that never has anything to give, like a decoder that can't keep up
+    class StarvingDevice : public QIODevice
+    {
+    public:
+        bool isSequential() const {return true;}
+        bool atEnd() const {return false;}
+
+    protected:
+        qint64 readData(char*, qint64) {return 0;}
+        qint64 writeData(const char*, qint64 _length) {return _length;}
+    };
+}
+
+int testLatencyStats()
+{
+    int failures = 0;
+
+    LatencyStats stats;
+    failures += CHECK(stats.count() == 0);
+    failures += CHECK(stats.percentile(99.0) == 0);
+
+    for(int i = 1; i <= 100; ++i)
+        stats.addSample(i);
+    failures += CHECK(stats.count() == 100);
+    failures += CHECK(stats.minimum() == 1);
+    failures += CHECK(stats.maximum() == 100);
+    failures += CHECK(qFuzzyCompare(stats.average(), 50.5));
+    failures += CHECK(stats.percentile(50.0) == 50);
+    failures += CHECK(stats.percentile(99.0) == 99);
+
+    //The percentiles only see the last window, the rest covers every sample
+    for(int i = 0; i < LatencyStats::kWindow; ++i)
+        stats.addSample(1000);
+    failures += CHECK(stats.count() == 100 + LatencyStats::kWindow);
+    failures += CHECK(stats.minimum() == 1);
+    failures += CHECK(stats.percentile(1.0) == 1000);
+
+    stats.clear();
+    failures += CHECK(stats.count() == 0);
+    failures += CHECK(stats.maximum() == 0);
+
+    return failures;
+}
+
+int testNullAudioSink()
+{
+    int failures = 0;
+
+    //A starving source underruns once, then stays idle until it has data
+    StarvingDevice starving;
+    starving.open(QIODevice::ReadOnly);
+    NullAudioSink starved(cdFormat(), SOUND_NULL_PERIOD);
+    int underruns = 0;
+    QObject::connect(&starved, &NullAudioSink::stateChanged, [&](QAudio::State _state)
+    {
+        if(_state == QAudio::IdleState && starved.error() == QAudio::UnderrunError)
+            ++underruns;
+    });
+    starved.start(&starving);
+    failures += CHECK(runEventLoopUntil([&]() {return underruns > 0;}));
+    //Ten more periods on the clock of the sink, however long the machine takes to give them
+    qint64 underrunTime = starved.elapsedUSecs();
+    failures += CHECK(runEventLoopUntil([&]() {return starved.elapsedUSecs() >= underrunTime + 10*SOUND_NULL_PERIOD*1000;}));
+    failures += CHECK(underruns == 1);
+    failures += CHECK(starved.processedUSecs() == 0);
+    starved.stop();
+
+    //A buffer is played to its end at the rate of the format, without underrun
+    QByteArray samples(cdFormat().bytesForDuration(50000), 0);
+    QBuffer buffer(&samples);
+    buffer.open(QIODevice::ReadOnly);
+    NullAudioSink sink(cdFormat(), SOUND_NULL_PERIOD);
+    int notifications = 0;
+    int aheadOfTime = 0;
+    QObject::connect(&sink, &NullAudioSink::notify, [&]()
+    {
+        //Real time, not as fast as it can read : never more than its own clock less one period
+        ++notifications;
+        if(sink.processedUSecs() > sink.elapsedUSecs() - SOUND_NULL_PERIOD*1000)
+            ++aheadOfTime;
+    });
+    sink.setNotifyInterval(SOUND_NOTIFY_INTERVAL);
+    sink.start(&buffer);
+    failures += CHECK(runEventLoopUntil([&]() {return sink.state() == QAudio::IdleState;}));
+    failures += CHECK(aheadOfTime == 0);
+    failures += CHECK(sink.processedUSecs() == 50000);
+    failures += CHECK(sink.elapsedUSecs() >= 50000 + SOUND_NULL_PERIOD*1000);
+    failures += CHECK(sink.state() == QAudio::IdleState);
+    failures += CHECK(sink.error() == QAudio::NoError);
+    failures += CHECK(notifications > 0);
+
+    return failures;
+}
+
+int testSoundEngineNullSink()
+{
+    int failures = 0;
+    const int nbTriggers = 20;
+
+    SoundEngine engine(100, 100, 0, true);
+    failures += CHECK(engine.isNullSink());
+
+    //Each trigger comes as soon as the previous one is measured, so every trigger after
+    //the first one restarts a voice that is still playing
+    const LatencyStats& latency = engine.triggerLatency();
+    for(int i = 0; i < nbTriggers; ++i)
+    {
+        engine.playSound(ShootSound);
+        failures += CHECK(runEventLoopUntil([&]() {return latency.count() == i+1;}));
+    }
+
+    //The sink holds the first sample back for one period of its own clock, and the position
+    //it reports is what it really consumed : the measure can't be below that period.
+    //There is no upper bound, it would only measure how loaded the machine is
+    qDebug() << "Null sink trigger latency :" << latency.summary("us");
+    failures += CHECK(latency.count() == nbTriggers);
+    failures += CHECK(latency.minimum() >= SOUND_NULL_PERIOD*1000);
+    failures += CHECK(latency.average() >= latency.minimum() && latency.average() <= latency.maximum());
+    failures += CHECK(engine.underrunCount() == 0);
+
+    return failures;
+}
@@ -0,0 +1,88 @@
+#include "tests/Tests.h"
+#include "include/utils/StepRotation.h"
+#include "include/utils/PowerSteps.h"
+#include "include/config/Define.h"
+
+namespace
+{
+    //Walks _nbSteps next() against cos/sin of the argument summed step by step, like the movers did
+    int checkRotationDrift(qreal _argument, qreal _step, int _nbSteps)
+    {
+        StepRotation l_rotation(_argument, _step);
+        qreal l_argument = _argument;
+        qreal l_drift = 0.0;
+        qreal l_radius = 0.0;
+
+        for(int i = 0;i<_nbSteps;i++)
+        {
+            l_rotation.next();
+            l_argument += _step;
+            l_drift = qMax(l_drift, qMax(fabs(l_rotation.cosine()-cos(l_argument)), fabs(l_rotation.sine()-sin(l_argument))));
+            l_radius = qMax(l_radius, fabs(l_rotation.cosine()*l_rotation.cosine()+l_rotation.sine()*l_rotation.sine()-1.0));
+        }
+
+        qDebug() << "StepRotation step" << _step << ": drift" << l_drift << "radius error" << l_radius << "after" << _nbSteps << "steps";
+        return CHECK(l_drift < 1e-8) + CHECK(l_radius < 1e-12);
+    }
+
+    //y offset of a ProjectileMulti after each tick, factored against the direct pow(|x-x0|, power)
+    int checkMultiTrajectory(qreal _coeff, qreal _power, qreal _angle)
+    {
+        const qreal l_speed = SPEED_MULTI_DEF;
+        const qreal l_stepX = l_speed*cos(_angle);
+        const qreal l_scale = l_speed*_coeff*pow(fabs(l_stepX), _power);
+        PowerSteps l_powers(_power);
+
+        const qreal l_x0 = 640.5;
+        qreal l_x = l_x0;
+        qreal l_error = 0.0;
+        for(int n = 0;n<2*MULTI_POWER_TABLE_SIZE;n++)
+        {
+            qreal l_direct = l_speed*_coeff*pow(fabs(l_x-l_x0), _power);
+            l_error = qMax(l_error, fabs(l_scale*l_powers.at(n)-l_direct));
+            l_x += l_stepX;
+        }
+
+        return CHECK(l_error < 1e-9);
+    }
+}
+
+int testStepRotation()
+{
+    int failures = 0;
+    failures += checkRotationDrift(0.3, ARG_INCREMENTATION_ALIENSPACESHIP, 200000);
+    failures += checkRotationDrift(-1.2, -ARG_INCREMENTATION_BONUS, 200000);
+    failures += checkRotationDrift(0.0, OMEGA_SPACESHIP_PROJ_V*SPEED_V_DEF*cos(0.4), 200000);
+
+    //setArgument() jumps without losing the step
+    StepRotation l_rotation(0.0, 0.25);
+    l_rotation.setArgument(1.0);
+    l_rotation.next();
+    failures += CHECK(fabs(l_rotation.cosine()-cos(1.25)) < 1e-12);
+    failures += CHECK(fabs(l_rotation.sine()-sin(1.25)) < 1e-12);
+    return failures;
+}
+
+int testProjectileMultiPowers()
+{
+    int failures = 0;
+
+    //The table and the pow() beyond it give the same values
+    const qreal l_exponents[] = {0.0, 1.0/2.0, 1.0/3.0, 1.0/4.0, 1.0/5.0};
+    for(int i = 0;i<5;i++)
+    {
+        PowerSteps l_powers(l_exponents[i]);
+        qreal l_error = 0.0;
+        for(int n = 0;n<2*MULTI_POWER_TABLE_SIZE;n++)
+            l_error = qMax(l_error, fabs(l_powers.at(n)-pow(static_cast<qreal>(n), l_exponents[i])));
+        failures += CHECK(l_error == 0.0);
+    }
+
+    //The coefficients and exponents fired by Spaceship, to the right and to the left
+    failures += checkMultiTrajectory(1, 0, -0.3);
+    failures += checkMultiTrajectory(-0.25, 1.0/2.0, -0.3);
+    failures += checkMultiTrajectory(0.6, 1.0/3.0, 0.2);
+    failures += checkMultiTrajectory(0.8, 1.0/4.0, M_PI-0.3);
+    failures += checkMultiTrajectory(-0.8, 1.0/5.0, M_PI+0.2);
+    return failures;
+}
@@ -0,0 +1,22 @@
+#ifndef TESTS_H
+#define TESTS_H
+
+#include <functional>
+
+//Each test returns its number of failed checks, TestMain adds them up
+#define CHECK(condition) checkThat((condition), #condition, __FILE__, __LINE__)
+
+int checkThat(bool _condition, const char* _expression, const char* _file, int _line);
+//Runs the event loop of the application for _ms milliseconds
+void runEventLoop(int _ms);
+//Runs the event loop until _condition holds, false if it still doesn't after _timeoutMs.
+//The timeout is only a guard, the checks never depend on how long it took
+bool runEventLoopUntil(const std::function<bool()>& _condition, int _timeoutMs = 5000);
+
+int testLatencyStats();
+int testNullAudioSink();
+int testSoundEngineNullSink();
+int testStepRotation();
+int testProjectileMultiPowers();
+
+#endif // TESTS_H